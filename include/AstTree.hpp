@@ -12,11 +12,37 @@
 #include <optional>
 #include <variant>
 #include <iomanip>
+#include <functional>
 
 enum class LiteralType {
-    UNKNOWN, INT_32, INT_64, FLOAT, DOUBLE, STRING, BOOL, STRUCT
+    UNKNOWN, INT_32, INT_64, FLOAT, DOUBLE, STRING, BOOL, STRUCT,
+    INT_8, INT_16, UINT_8, UINT_16, UINT_32, UINT_64
 };
 
+// llvm tidak membedakan signed / unsigned, jadi ditandai dari tipe bahasa
+inline bool isUnsignedType(LiteralType t){
+    return t == LiteralType::UINT_8 || t == LiteralType::UINT_16 || t == LiteralType::UINT_32 || t == LiteralType::UINT_64;
+}
+
+// nama tipe hasil typeof
+inline std::string literalTypeName(LiteralType t){
+    switch(t){
+        case LiteralType::INT_8: return "i8";
+        case LiteralType::INT_16: return "i16";
+        case LiteralType::INT_32: return "i32";
+        case LiteralType::INT_64: return "i64";
+        case LiteralType::UINT_8: return "u8";
+        case LiteralType::UINT_16: return "u16";
+        case LiteralType::UINT_32: return "u32";
+        case LiteralType::UINT_64: return "u64";
+        case LiteralType::FLOAT: return "f32";
+        case LiteralType::DOUBLE: return "double";
+        case LiteralType::BOOL: return "bool";
+        case LiteralType::STRING: return "str";
+        default: return "unknown";
+    }
+}
+
 enum class StmtType {
     Program, VarDecl, Assignment,
     Print, If, Elif, For,
@@ -24,7 +50,8 @@ enum class StmtType {
     FunctionDecl, Return, Break, Continue,
     BinaryOp, Literal, Identifier,
     FunctionCall, Typeof, Input, 
-    StructDecl, StructInit, MemberAccess
+    StructDecl, StructInit, MemberAccess,
+    DynArrayNew, Comptime
 };
 
 struct Stmt {
@@ -47,6 +74,9 @@ struct VarDeclStmt: public Stmt {
     LiteralType varType;
     std::shared_ptr<Stmt> initializer;
     bool hasExplicit;
+    bool isArray = false; // parameter array<tipe>: dikirim sebagai pointer data + panjang
+    std::string structName = ""; // tipe struct (parameter p: Point / var p: Point)
+    bool isConst = false; // const x = ...: nilainya harus konstan dan tidak boleh di-assign
     VarDeclStmt(const std::string n, std::shared_ptr<Stmt> init, LiteralType ty, bool explicitTy)
         : Stmt(StmtType::VarDecl), name(n), initializer(init), varType(ty), hasExplicit(explicitTy) {}
 };
@@ -57,9 +87,10 @@ struct VarDeclStmt: public Stmt {
 struct AssignmentStmt: public Stmt {
     std::string name;
     std::shared_ptr<Stmt> value;
-    std::shared_ptr<Stmt> index;
-    AssignmentStmt(const std::string& n, std::shared_ptr<Stmt> val, std::shared_ptr<Stmt> idx = nullptr)
-        : Stmt(StmtType::Assignment), name(n), value(val), index(idx) {}
+    std::vector<std::shared_ptr<Stmt>> indices; // kosong = bukan elemen array, m[i][j] = 2 index
+    std::vector<std::string> members; // field struct yang ditulis: p.pos.x = 1 -> {pos, x}
+    AssignmentStmt(const std::string& n, std::shared_ptr<Stmt> val, const std::vector<std::shared_ptr<Stmt>>& idx = {})
+        : Stmt(StmtType::Assignment), name(n), value(val), indices(idx) {}
 };
 
 
@@ -125,11 +156,20 @@ struct ArrayLiteralStmt : public Stmt {
         : Stmt(StmtType::ArrayLiteral), elements(elems) {}
 };
 
+// array<f64>(n) / array<f64>(rows, cols): array dinamis di heap, ukuran baru diketahui saat runtime
+struct DynArrayExpr : public Stmt {
+    LiteralType elemType;
+    std::vector<std::shared_ptr<Stmt>> sizes; // 1 ukuran per dimensi, kosong = array kosong
+    std::string structName = ""; // array<Point>(n): elemen struct
+    DynArrayExpr(LiteralType ty, const std::vector<std::shared_ptr<Stmt>>& sz)
+        : Stmt(StmtType::DynArrayNew), elemType(ty), sizes(sz) {}
+};
+
 struct ArrayAccessStmt : public Stmt {
     std::string array_name;
-    std::shared_ptr<Stmt> index;
-    ArrayAccessStmt(const std::string& name, std::shared_ptr<Stmt> idx)
-        : Stmt(StmtType::ArrayAccess), array_name(name), index(idx) {}
+    std::vector<std::shared_ptr<Stmt>> indices; // m[i][j] -> {i, j}
+    ArrayAccessStmt(const std::string& name, const std::vector<std::shared_ptr<Stmt>>& idx)
+        : Stmt(StmtType::ArrayAccess), array_name(name), indices(idx) {}
 };
 
 // -------------------- Function --------------------
@@ -137,6 +177,12 @@ struct FunctionDeclStmt : public Stmt {
     std::string name;
     std::vector<std::shared_ptr<Stmt>> params;
     std::vector<std::shared_ptr<Stmt>> body;
+    // tipe return eksplisit (fun f(): f64 / : Point / : array<f64>), kalau tidak ada disimpulkan dari return
+    bool hasReturnType = false;
+    LiteralType returnType = LiteralType::UNKNOWN;
+    std::string returnStruct = "";
+    bool returnsArray = false;
+    std::vector<std::string> annotations; // @inline / @noinline / @cold
 
     FunctionDeclStmt(const std::string& n,
                      const std::vector<std::shared_ptr<Stmt>>& p,
@@ -174,6 +220,8 @@ struct UnaryOpStmt : public Stmt {
 struct LiteralStmt : public Stmt {
     std::variant<int32_t, int64_t, double, std::string, bool> value;
     LiteralType dataType = LiteralType::UNKNOWN;
+    // hasil constant folding / nilai variabel konstan: tipenya sudah pasti, tidak ikut tipe operand pasangannya
+    bool folded = false;
 
     explicit LiteralStmt(const std::string& s)
         : Stmt(StmtType::Literal), value(s), dataType(LiteralType::STRING) {}
@@ -185,7 +233,7 @@ struct LiteralStmt : public Stmt {
         : Stmt(StmtType::Literal), value(i), dataType(LiteralType::INT_64) {}
     
     explicit LiteralStmt(float f)
-        : Stmt(StmtType::Literal), value(static_cast<double>(f)), dataType(LiteralType::DOUBLE) {}
+        : Stmt(StmtType::Literal), value(static_cast<double>(f)), dataType(LiteralType::FLOAT) {}
     
     explicit LiteralStmt(double d)
         : Stmt(StmtType::Literal), value(d), dataType(LiteralType::DOUBLE) {}
@@ -214,6 +262,13 @@ struct TypeofStmt : public Stmt {
         : Stmt(StmtType::Typeof), expression(expr) {}
 };
 
+// comptime f(x): dihitung saat compile oleh ComptimeEvaluator, diganti literal hasilnya sebelum codegen
+struct ComptimeStmt : public Stmt {
+    std::shared_ptr<Stmt> expression;
+    ComptimeStmt(std::shared_ptr<Stmt> expr)
+        : Stmt(StmtType::Comptime), expression(expr) {}
+};
+
 struct InputStmt : public Stmt {
     std::shared_ptr<Stmt> expr;
     std::string dataType;
@@ -235,6 +290,7 @@ struct ContinueStmt : public Stmt {
 struct StructField {
     std::string name;
     LiteralType type;
+    std::string structName = ""; // field bertipe struct lain (type = STRUCT)
 
     StructField(std::string& n, LiteralType ty)
         : name(n), type(ty) {}
@@ -243,6 +299,7 @@ struct StructField {
 struct StructStmt : public Stmt {
     std::string name;
     std::vector<std::shared_ptr<StructField>> fields;
+    std::vector<std::string> annotations; // @soa
     
     StructStmt(const std::string& n, const std::vector<std::shared_ptr<StructField>>& fld)
         : Stmt(StmtType::StructDecl), name(n), fields(fld) {}
@@ -268,6 +325,76 @@ struct MemberAccessExpr : Stmt {
 };
 
 
+// panggil fn untuk tiap anak langsung dari stmt (ekspresi dan isi blok), dipakai analisis AST
+inline void forEachChild(const std::shared_ptr<Stmt>& stmt, const std::function<void(const std::shared_ptr<Stmt>&)>& fn) {
+    if (!stmt) return;
+    auto each = [&](const std::vector<std::shared_ptr<Stmt>>& list) {
+        for (const auto& s : list) if (s) fn(s);
+    };
+    auto one = [&](const std::shared_ptr<Stmt>& s) { if (s) fn(s); };
+
+    switch (stmt->type) {
+        case StmtType::Program: each(std::static_pointer_cast<ProgramStmt>(stmt)->statements); break;
+        case StmtType::VarDecl: one(std::static_pointer_cast<VarDeclStmt>(stmt)->initializer); break;
+        case StmtType::Assignment: {
+            auto assign = std::static_pointer_cast<AssignmentStmt>(stmt);
+            one(assign->value);
+            each(assign->indices);
+            break;
+        }
+        case StmtType::Print: one(std::static_pointer_cast<PrintStmt>(stmt)->expression); break;
+        case StmtType::If: {
+            auto ifs = std::static_pointer_cast<IfStmt>(stmt);
+            one(ifs->condition);
+            each(ifs->then_block);
+            for (const auto& elif : ifs->elifs) one(elif);
+            each(ifs->else_block);
+            break;
+        }
+        case StmtType::Elif: {
+            auto elif = std::static_pointer_cast<ElifStmt>(stmt);
+            one(elif->condition);
+            each(elif->block);
+            break;
+        }
+        case StmtType::For: {
+            auto fs = std::static_pointer_cast<ForStmt>(stmt);
+            one(fs->start);
+            one(fs->end);
+            one(fs->step);
+            each(fs->block);
+            break;
+        }
+        case StmtType::ArrayLiteral: each(std::static_pointer_cast<ArrayLiteralStmt>(stmt)->elements); break;
+        case StmtType::ArrayAccess: each(std::static_pointer_cast<ArrayAccessStmt>(stmt)->indices); break;
+        case StmtType::UnaryOp: one(std::static_pointer_cast<UnaryOpStmt>(stmt)->operand); break;
+        case StmtType::FunctionDecl: {
+            auto decl = std::static_pointer_cast<FunctionDeclStmt>(stmt);
+            each(decl->params);
+            each(decl->body);
+            break;
+        }
+        case StmtType::Return: one(std::static_pointer_cast<ReturnStmt>(stmt)->value); break;
+        case StmtType::BinaryOp: {
+            auto bin = std::static_pointer_cast<BinaryOpStmt>(stmt);
+            one(bin->left);
+            one(bin->right);
+            break;
+        }
+        case StmtType::FunctionCall: each(std::static_pointer_cast<FunctionCallStmt>(stmt)->args); break;
+        case StmtType::Typeof: one(std::static_pointer_cast<TypeofStmt>(stmt)->expression); break;
+        case StmtType::Comptime: one(std::static_pointer_cast<ComptimeStmt>(stmt)->expression); break;
+        case StmtType::Input: one(std::static_pointer_cast<InputStmt>(stmt)->expr); break;
+        case StmtType::StructInit:
+            for (const auto& f : std::static_pointer_cast<StructExpr>(stmt)->fieldsValue) one(f.second);
+            break;
+        case StmtType::MemberAccess: one(std::static_pointer_cast<MemberAccessExpr>(stmt)->object); break;
+        case StmtType::DynArrayNew: each(std::static_pointer_cast<DynArrayExpr>(stmt)->sizes); break;
+        default: break; // Literal, Identifier, Break, Continue, StructDecl
+    }
+}
+
+
 
 
 
@@ -435,10 +562,19 @@ inline void printStmt(const std::shared_ptr<Stmt>& stmt, int level = 0) {
             break;
         }
 
+        case StmtType::DynArrayNew: {
+            auto dyn = std::static_pointer_cast<DynArrayExpr>(stmt);
+            indent(level); std::cout << "DynArray (type: " << static_cast<int>(dyn->elemType) << ")" << std::endl;
+            for (const auto& s : dyn->sizes)
+                printStmt(s, level + 1);
+            break;
+        }
+
         case StmtType::ArrayAccess: {
             auto acc = std::static_pointer_cast<ArrayAccessStmt>(stmt);
             indent(level); std::cout << "ArrayAccess: " << acc->array_name << std::endl;
-            printStmt(acc->index, level + 1);
+            for (const auto& idx : acc->indices)
+                printStmt(idx, level + 1);
             break;
         }
 
@@ -456,6 +592,13 @@ inline void printStmt(const std::shared_ptr<Stmt>& stmt, int level = 0) {
             break;
         }
 
+        case StmtType::Comptime: {
+            auto comptime = std::static_pointer_cast<ComptimeStmt>(stmt);
+            indent(level); std::cout << "Comptime" << std::endl;
+            printStmt(comptime->expression, level + 1);
+            break;
+        }
+
         case StmtType::Return: {
             auto ret = std::static_pointer_cast<ReturnStmt>(stmt);
             indent(level); std::cout << "Return" << std::endl;
@@ -468,7 +611,8 @@ inline void printStmt(const std::shared_ptr<Stmt>& stmt, int level = 0) {
             auto assign = std::static_pointer_cast<AssignmentStmt>(stmt);
             indent(level); std::cout << "Assignment: " << assign->name << std::endl;
             printStmt(assign->value, level + 1);
-            if(assign->index) printStmt(assign->value, level + 1);
+            for (const auto& idx : assign->indices)
+                printStmt(idx, level + 1);
             break;
         }
         
@@ -13,22 +13,63 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
 #include <stdexcept>
 #include <utility>
+#include <functional>
 
-typedef struct {
-    llvm::AllocaInst* alloc;
+struct VarInfo {
+    llvm::Value* alloc; // alloca lokal, atau GlobalVariable untuk variabel top-level
     LiteralType dataType;
     bool isArray = false;
     size_t size = 1;
     bool staticType = false;
     std::string structTypeName = "";
-} VarInfo;
+    bool isDynamic = false; // array dinamis: alloc berisi header { T* data, i64 len, i64 cap }
+    std::vector<size_t> shape = {}; // ukuran tiap dimensi array statis (row-major)
+    bool isBorrowed = false; // parameter array: data milik pemanggil, tidak bisa push / pop / reserve
+
+    llvm::Type* storageType() const { return alloc->getType()->getPointerElementType(); }
+    uint64_t storageAlign() const {
+        if(auto* global = llvm::dyn_cast<llvm::GlobalVariable>(alloc)) return global->getAlign().valueOrOne().value();
+        return llvm::cast<llvm::AllocaInst>(alloc)->getAlign().value();
+    }
+};
 
 struct StructInfo {
     llvm::StructType* type;
     std::unordered_map<std::string, unsigned> fieldIndices;
+    std::unordered_map<std::string, LiteralType> fieldTypes;
+    std::unordered_map<std::string, std::string> fieldStructs; // field bertipe struct -> nama struct-nya
+    std::vector<std::string> fieldOrder; // urutan field di source (@reorder bisa mengubah urutan di memori)
+    bool soa = false; // @soa: array struct ini disimpan per field (satu kolom per field)
+};
+
+// parameter function, array dikirim sebagai pointer data + panjang (tanpa salin)
+struct ParamInfo {
+    std::string name;
+    LiteralType dataType;
+    bool isArray = false;
+    bool writes = false; // isi array diubah di function ini (atau function yang dipanggilnya)
+    std::string structName = ""; // parameter struct: kecil lewat register, besar lewat pointer readonly
+};
+
+// signature function user. skalar, str dan struct kecil dikembalikan lewat register,
+// struct besar dan array lewat buffer milik pemanggil (sret)
+struct FunctionInfo {
+    std::vector<ParamInfo> params;
+    LiteralType returnType = LiteralType::UNKNOWN; // UNKNOWN = tidak mengembalikan nilai (void)
+    std::string returnStruct = "";
+    bool returnsArray = false; // hasil berupa header array dinamis { data, len, cap }
+    bool sret = false; // diisi saat function dibuat
+    bool returnsAggregate() const { return returnsArray || !returnStruct.empty(); }
+};
+
+// function dengan parameter tanpa tipe, dibuat instance-nya per kombinasi tipe argumen
+struct GenericFunction {
+    std::shared_ptr<FunctionDeclStmt> decl;
+    size_t scopeDepth; // jumlah scope yang terlihat saat function dideklarasikan
 };
 
 class CodeGen {
@@ -41,6 +82,22 @@ private:
     std::vector<llvm::BasicBlock*> ContinueTargets;
     std::shared_ptr<ProgramStmt> ast_tree;
     std::unordered_map<std::string, StructInfo> StructTypes;
+    std::unordered_map<std::string, llvm::GlobalVariable*> StringLiterals; // literal yang sama cukup 1 global
+    std::set<std::string> WrittenNames; // nama yang di-assign / dikirim ke function yang bisa mengubahnya
+    std::set<std::string> GlobalDataUsers; // function yang (juga lewat call) mengakses array / struct global
+    llvm::StructType* strType = nullptr; // str = { i8* ptr, i64 len }
+    unsigned vectorBytes = 16; // lebar register SIMD CPU host (SSE 16, AVX 32, AVX-512 64)
+    std::set<std::string> RegionSafeFunctions; // function yang data heap-nya tidak keluar dari function
+    llvm::Value* FunctionArenaMark = nullptr; // mark arena function aktif, di-pop sebelum return
+    std::set<llvm::Value*> UnsignedValues; // nilai integer hasil tipe unsigned (u8..u64), konstanta tidak dicatat
+    std::unordered_map<std::string, FunctionInfo> Functions; // signature tiap function user
+    std::unordered_map<std::string, GenericFunction> GenericFunctions;
+    std::unordered_map<llvm::Value*, std::string> CallResults; // buffer hasil call struct / array -> function (instance) pemanggilnya
+    FunctionInfo* InferringReturn = nullptr; // generate percobaan untuk mencari tipe return, handleReturn mencatat ke sini
+    // return f(...) di dalam f: argumen baru ditulis ke alloca parameter lalu lompat ke awal body
+    llvm::BasicBlock* TailRecurseBlock = nullptr;
+    std::vector<llvm::Value*> TailRecurseParams; // alloca parameter, urut sesuai deklarasi
+    size_t TailRecurseLoopDepth = 0; // jumlah loop aktif saat body dimulai, return di dalam loop tidak diubah
 
 
 
@@ -51,29 +108,71 @@ private:
 
     void handlePrint(const std::shared_ptr<PrintStmt>& printStmtObj, bool enter = true);
     void handlePrintArray(const VarInfo* varInfo);
+    void handlePrintStruct(llvm::Value* ptr, const std::string& structName, bool enter = true);
     void handleVarDeclaration(const std::shared_ptr<VarDeclStmt>& varDeclStmt);
+    void markReadOnlyGlobal(const std::shared_ptr<VarDeclStmt>& varDeclStmt);
     void handleAssignment(const std::shared_ptr<AssignmentStmt>& assignmentStmt);
     void handleIf(const std::shared_ptr<IfStmt>& ifStmt);
     void handleFor(const std::shared_ptr<ForStmt>& forStmt);
     void handleReturn(const std::shared_ptr<ReturnStmt>& ret);
     void handleFunctionDecl(const std::shared_ptr<FunctionDeclStmt>& funcDecl);
+    llvm::Function* emitFunction(const std::shared_ptr<FunctionDeclStmt>& funcDecl, FunctionInfo& info);
+    void applyFunctionAnnotations(llvm::Function* function, const std::vector<std::string>& annotations);
+    void inferFunctionAttributes(llvm::Function* function);
+    static llvm::Value* baseObject(llvm::Value* ptr);
+    void inferReturnType(const std::shared_ptr<FunctionDeclStmt>& funcDecl, FunctionInfo& info);
+    llvm::Type* functionReturnType(const FunctionInfo& info);
+    std::string instantiateGeneric(const std::string& name, const std::vector<ParamInfo>& argTypes);
+    void storeReturnedArray(VarInfo* var, llvm::Value* dest);
+    bool emitSelfTailCall(const std::shared_ptr<FunctionCallStmt>& call, llvm::Function* func);
+    void markTailCall(llvm::Value* retVal, llvm::Function* func);
+    bool structInRegisters(llvm::StructType* structTy);
+    std::string structNameOf(llvm::Value* val);
+    llvm::Value* structPointer(const std::shared_ptr<Stmt>& expr, std::string& structName);
+    llvm::Value* memberPointer(const std::shared_ptr<Stmt>& object, const std::string& fieldName, std::string& structName);
+    bool isSoaArray(const VarInfo* var);
+    llvm::Value* soaColumn(const VarInfo* var, unsigned field);
+    llvm::Value* structArrayField(const VarInfo* var, llvm::Value* idx, const std::string& fieldName);
+    llvm::Value* loadStructElement(const VarInfo* var, llvm::Value* idx);
+    void storeStructElement(const VarInfo* var, llvm::Value* idx, llvm::Value* value);
     void handleStructDecl(const std::shared_ptr<StructStmt>& structStmt);
 
     llvm::Value* generateLiteral(const std::shared_ptr<LiteralStmt>& literalStmt);
-    llvm::Value* generateArrayLiteral(const std::shared_ptr<ArrayLiteralStmt>& arrStmt);
+    llvm::Value* generateArrayLiteral(const std::shared_ptr<ArrayLiteralStmt>& arrStmt, LiteralType elemType = LiteralType::UNKNOWN,
+                                      LiteralType* resultType = nullptr);
     llvm::Value* generateIdentifier(const std::shared_ptr<IdentifierStmt>& identifierStmt);
     llvm::Value* generateUnary(const std::shared_ptr<UnaryOpStmt>& unary);
     llvm::Value* generateBinary(const std::shared_ptr<BinaryOpStmt>& binOp);
+    llvm::Value* generateLogical(const std::shared_ptr<BinaryOpStmt>& binOp);
     llvm::Value* generateTypeof(const std::shared_ptr<TypeofStmt>& typeOfStmtObj);
     llvm::Value* generateInput(const std::shared_ptr<InputStmt>& inputStmt);
     llvm::Value* generateArrayAccess(const std::shared_ptr<ArrayAccessStmt>& accessStmt);
-    llvm::Value* generateArrayElementPtr(VarInfo* var, llvm::Value* idxVal);
+    llvm::Value* generateArrayIndex(VarInfo* var, const std::vector<llvm::Value*>& indices);
     llvm::Value* generateFunctionCall(const std::shared_ptr<FunctionCallStmt>& callStmt);
     llvm::Value* generateStructInit(const std::shared_ptr<StructExpr>& structInitStmt);
     llvm::Value* generateMemberAccess(const std::shared_ptr<MemberAccessExpr>& memberStmt);
+    llvm::Value* generateBuiltinCall(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    llvm::Value* generateSaveLoad(const std::shared_ptr<FunctionCallStmt>& callStmt, bool save);
+    llvm::Value* generateLen(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    llvm::Value* generateShape(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    llvm::Value* generateStringBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    llvm::Value* generateDynArray(const std::shared_ptr<DynArrayExpr>& dynStmt);
+    llvm::Value* generateDynArrayBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    bool isElementwiseExpr(const std::shared_ptr<Stmt>& expr);
+    void generateElementwise(const std::string& targetName, const std::shared_ptr<Stmt>& expr, bool declare);
+    llvm::Value* generateReduction(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    llvm::Value* generateBitArrayBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    llvm::Value* generateBitBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt);
+    llvm::Value* emitBitReduce(const VarInfo* var, const std::string& kind);
+    llvm::Value* emitBinaryOp(const std::string& op, llvm::Value* left, llvm::Value* right);
+    llvm::Value* emitUnaryOp(const std::string& op, llvm::Value* operand);
+    llvm::Type* promoteBinaryType(llvm::Type* left, llvm::Type* right);
     
     llvm::Function* getPrintf(llvm::Module *m);
     void genPrintString(llvm::Value *strVal, bool enter = true);
+    llvm::Constant* getCString(const std::string& text);
+    llvm::Constant* getStringLiteral(const std::string& text);
+    llvm::Value* makeString(llvm::Value* ptr, llvm::Value* len);
     void genPrintInt(llvm::Value *intVal, bool enter = true);
     void genPrintDouble(llvm::Value *floatVal, bool enter = true);
 
@@ -89,24 +188,55 @@ private:
         llvm::Type *type,
         int n = 1
     );
+    llvm::Value* createVariableStorage(const std::string& name, llvm::Type* type);
+    void storeInitialValue(llvm::Value* storage, llvm::Value* value);
+    void collectWrittenNames(const std::shared_ptr<Stmt>& stmt);
 
     void enterScope();
     void exitScope();
     VarInfo* lookupVariable(const std::string& name);
 
     
-    size_t sizeofArray(const std::shared_ptr<ArrayLiteralStmt>& arrStmt);
+    std::vector<size_t> arrayLiteralShape(const std::shared_ptr<ArrayLiteralStmt>& arrStmt);
+    llvm::Type* getArrayElementType(const VarInfo* var);
+    bool isBitArray(const VarInfo* var);
+    llvm::Value* bitWordCount(llvm::Value* len);
+    llvm::Value* getArrayDataPtr(const VarInfo* var);
+    llvm::Value* getArrayLength(const VarInfo* var);
+    size_t getArrayRank(const VarInfo* var);
+    llvm::Value* getArrayDim(const VarInfo* var, size_t dim);
+    llvm::StructType* getDynArrayType(llvm::Type* elemTy, size_t rank = 1);
+    unsigned vectorLanes(const std::vector<llvm::Type*>& elemTypes);
+    llvm::Value* loadArrayLanes(const VarInfo* var, llvm::Value* data, llvm::Value* idx, unsigned vf);
+    void storeArrayLanes(const VarInfo* var, llvm::Value* data, llvm::Value* idx, llvm::Value* val);
+    void genRuntimeError(llvm::Value* cond, const std::string& message);
+    std::vector<llvm::Value*> emitCountedLoop(
+        llvm::Value* begin, llvm::Value* end, uint64_t step, const std::string& name,
+        const std::vector<llvm::Value*>& init,
+        const std::function<std::vector<llvm::Value*>(llvm::Value*, const std::vector<llvm::Value*>&)>& body
+    );
+    void scanParamWrites(const std::shared_ptr<FunctionDeclStmt>& funcDecl, std::vector<ParamInfo>& params);
+    void scanArenaRegion(const std::vector<std::shared_ptr<Stmt>>& body, std::set<std::string> declared,
+                         const std::string& selfName, bool& allocates, bool& escapes);
+    llvm::Value* beginArenaScope();
+    void releaseArenaScope(llvm::Value* mark, bool pop);
     llvm::Value* getBracketString(bool left);    
     llvm::Value* generateStringEq(llvm::Value* lhs, llvm::Value* rhs);
 
 
     llvm::Type* literalTypeToLLVM(LiteralType type);
+    llvm::Value* castToType(llvm::Value* val, llvm::Type* ty, bool toUnsigned = false);
+    llvm::Value* adaptLiteral(const std::shared_ptr<Stmt>& expr, llvm::Value* val, llvm::Type* ty, bool toUnsigned = false);
+    llvm::Value* markUnsigned(llvm::Value* val, bool isUnsigned = true);
+    bool isUnsignedValue(llvm::Value* val);
+    LiteralType valueLiteralType(llvm::Value* val);
     llvm::Constant* defaultValueForType(LiteralType type);
-    LiteralType inferLiteralTypeFromLLVM(llvm::Type* t);
+    LiteralType inferLiteralTypeFromLLVM(llvm::Type* t, bool isUnsigned = false);
     
 
 public:
-    CodeGen(const std::shared_ptr<ProgramStmt>& ast_tree);
+    // keepUnused: function / struct / variabel yang tidak terpakai tetap di-generate
+    CodeGen(const std::shared_ptr<ProgramStmt>& ast_tree, bool keepUnused = false);
     ~CodeGen(){}
     void run(bool printIr = false);
 };
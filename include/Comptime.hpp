@@ -0,0 +1,68 @@
+#ifndef COMPTIME_HPP
+#define COMPTIME_HPP
+
+#include "./AstTree.hpp"
+#include <map>
+#include <stdexcept>
+
+struct ComptimeStorage;
+
+// nilai saat compile: skalar, array (isinya dipakai bersama seperti array di runtime) atau struct
+struct ComptimeValue {
+    LiteralType type = LiteralType::UNKNOWN; // tipe skalar / tipe elemen array, UNKNOWN = tidak ada nilai
+    std::string structName = "";             // struct / array of struct
+    int64_t i = 0;                           // integer (sudah dipotong ke lebar tipenya) dan bool
+    double f = 0;                            // f32 / f64
+    std::string s;
+    bool isArray = false;
+    std::shared_ptr<ComptimeStorage> data;   // elemen array / field struct (urut source)
+};
+
+struct ComptimeStorage {
+    std::vector<ComptimeValue> items;
+    std::vector<size_t> dims; // array: ukuran tiap dimensi
+};
+
+// interpreter AST untuk comptime: menjalankan function murni (tanpa print / input / file,
+// tanpa variabel luar yang bukan konstanta) dengan aturan tipe yang sama dengan codegen
+class ComptimeEvaluator {
+private:
+    enum class Flow { Normal, Break, Continue, Return };
+
+    const std::map<std::string, std::shared_ptr<FunctionDeclStmt>>& functions;
+    const std::map<std::string, std::shared_ptr<StructStmt>>& structs;
+    std::vector<std::map<std::string, ComptimeValue>> scopes;
+    std::vector<std::string> callStack;
+    ComptimeValue returnValue;
+    uint64_t steps = 0;
+
+    void tick();
+    [[noreturn]] void fail(const std::string& message) const;
+    ComptimeValue* variable(const std::string& name);
+    ComptimeValue defaultValue(LiteralType type, const std::string& structName);
+    ComptimeValue structValue(const std::string& name);
+    size_t fieldIndex(const std::string& structName, const std::string& field);
+    ComptimeValue* element(ComptimeValue& array, const std::vector<std::shared_ptr<Stmt>>& indices);
+    ComptimeValue* target(const std::string& name, const std::vector<std::shared_ptr<Stmt>>& indices, const std::vector<std::string>& members);
+
+    Flow execBlock(const std::vector<std::shared_ptr<Stmt>>& block);
+    Flow exec(const std::shared_ptr<Stmt>& stmt);
+    void declare(const std::shared_ptr<VarDeclStmt>& decl);
+    void assign(const std::shared_ptr<AssignmentStmt>& assign);
+    Flow execFor(const std::shared_ptr<ForStmt>& forStmt);
+
+    ComptimeValue eval(const std::shared_ptr<Stmt>& expr);
+    ComptimeValue evalArrayLiteral(const std::shared_ptr<ArrayLiteralStmt>& arr, LiteralType elemType);
+    ComptimeValue evalCall(const std::shared_ptr<FunctionCallStmt>& call);
+    ComptimeValue evalBitBuiltin(const std::shared_ptr<FunctionCallStmt>& call);
+    ComptimeValue evalBinary(const std::string& op, ComptimeValue left, ComptimeValue right, bool leftRaw, bool rightRaw);
+    ComptimeValue evalUnary(const std::string& op, const ComptimeValue& operand);
+public:
+    ComptimeEvaluator(const std::map<std::string, std::shared_ptr<FunctionDeclStmt>>& functions,
+                      const std::map<std::string, std::shared_ptr<StructStmt>>& structs);
+    ComptimeValue evaluate(const std::shared_ptr<Stmt>& expr);
+    static ComptimeValue castValue(const ComptimeValue& value, LiteralType type);
+    std::shared_ptr<Stmt> toStmt(const ComptimeValue& value);
+};
+
+#endif
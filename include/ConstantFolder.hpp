@@ -0,0 +1,43 @@
+#ifndef CONSTANT_FOLDER_HPP
+#define CONSTANT_FOLDER_HPP
+
+#include "./AstTree.hpp"
+#include "./Comptime.hpp"
+#include <map>
+#include <set>
+#include <stdexcept>
+
+// constant folding + propagation di level AST, dijalankan sekali sebelum codegen.
+// ekspresi yang semua operand-nya literal diganti literal hasilnya (aturan tipe sama dengan codegen),
+// variabel yang diinisialisasi konstan dan tidak pernah di-assign dibaca sebagai literal,
+// cabang if dengan kondisi konstan dibuang, ekspresi comptime dijalankan ComptimeEvaluator
+class ConstantFolder {
+private:
+    struct Binding {
+        std::shared_ptr<LiteralStmt> value; // nullptr = bukan konstan (menutupi nama di scope luar)
+        bool isConst = false;
+    };
+    std::vector<std::map<std::string, Binding>> scopes;
+    std::set<std::string> assigned; // nama yang pernah di-assign di mana pun
+    // function dan struct yang sudah dideklarasikan, dipakai comptime
+    std::map<std::string, std::shared_ptr<FunctionDeclStmt>> functions;
+    std::map<std::string, std::shared_ptr<StructStmt>> structs;
+
+    void collectAssigned(const std::shared_ptr<Stmt>& stmt);
+    const Binding* lookup(const std::string& name) const;
+    void declare(const std::shared_ptr<VarDeclStmt>& decl);
+
+    void foldBlock(std::vector<std::shared_ptr<Stmt>>& block);
+    void foldScoped(std::vector<std::shared_ptr<Stmt>>& block);
+    std::shared_ptr<Stmt> foldStatement(const std::shared_ptr<Stmt>& stmt);
+    std::shared_ptr<Stmt> foldIf(const std::shared_ptr<IfStmt>& ifStmt);
+    std::shared_ptr<Stmt> fold(const std::shared_ptr<Stmt>& expr);
+    std::shared_ptr<Stmt> foldComptime(const std::shared_ptr<ComptimeStmt>& comptime, LiteralType* resultType);
+
+    std::shared_ptr<LiteralStmt> foldBinary(const std::string& op, std::shared_ptr<LiteralStmt> left, std::shared_ptr<LiteralStmt> right);
+    std::shared_ptr<LiteralStmt> foldUnary(const std::string& op, const std::shared_ptr<LiteralStmt>& operand);
+public:
+    void run(const std::shared_ptr<ProgramStmt>& program);
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef DEAD_CODE_HPP
+#define DEAD_CODE_HPP
+
+#include "./AstTree.hpp"
+#include <map>
+#include <set>
+
+// eliminasi kode mati di level AST, dijalankan setelah ConstantFolder.
+// function yang tidak terjangkau dari kode top-level (lewat call graph), struct yang tidak dipakai
+// dan deklarasi variabel yang tidak pernah disebut (nilai awalnya tanpa efek samping) tidak di-generate
+class DeadCodeEliminator {
+private:
+    std::map<std::string, std::vector<std::shared_ptr<FunctionDeclStmt>>> functions;
+    std::map<std::string, std::shared_ptr<StructStmt>> structs;
+    std::set<std::string> called; // function yang terjangkau
+    std::set<std::string> used;   // nama variabel / struct yang disebut kode yang terjangkau
+
+    void collectDecls(const std::shared_ptr<Stmt>& stmt);
+    void mark(const std::shared_ptr<Stmt>& stmt);
+    void markFunction(const std::shared_ptr<FunctionDeclStmt>& decl);
+    void markStruct(const std::string& name);
+    bool isPure(const std::shared_ptr<Stmt>& expr);
+    bool sweep(std::vector<std::shared_ptr<Stmt>>& block);
+public:
+    void run(const std::shared_ptr<ProgramStmt>& program);
+};
+
+#endif
@@ -35,11 +35,18 @@ public:
     std::shared_ptr<Stmt> parseInput();
     std::shared_ptr<Stmt> parseStructDecl();
     std::shared_ptr<Stmt> parseStructInit();
+    std::shared_ptr<Stmt> parseDynArray();
     std::vector<std::shared_ptr<Stmt>> parseBlock();
     std::shared_ptr<Stmt> parseExpressionUntil(TokenType);
     std::shared_ptr<Stmt> parseExpression();
+    std::shared_ptr<Stmt> parseLogicalOr();
+    std::shared_ptr<Stmt> parseLogicalAnd();
     std::shared_ptr<Stmt> parseEquality();
     std::shared_ptr<Stmt> parseComparison();
+    std::shared_ptr<Stmt> parseBitwiseOr();
+    std::shared_ptr<Stmt> parseBitwiseXor();
+    std::shared_ptr<Stmt> parseBitwiseAnd();
+    std::shared_ptr<Stmt> parseShift();
     std::shared_ptr<Stmt> parseTerm();
     std::shared_ptr<Stmt> parseFactor();
     std::shared_ptr<Stmt> parseUnary();
@@ -4,9 +4,11 @@
 #include <string>
 
 enum class TokenType {
-    DOUBLE_LITERAL, INT_LITERAL, STRING_LITERAL, BOOLEAN_LITERAL,
+    DOUBLE_LITERAL, FLOAT_LITERAL, INT_LITERAL, STRING_LITERAL, BOOLEAN_LITERAL,
     TYPE,
     VAR,
+    CONST,
+    COMPTIME,
     PRINT,
     IF,
     ELIF,
@@ -37,6 +39,7 @@ enum class TokenType {
 
     STRUCT,
     DOT,
+    ANNOTATION, // @soa, value tanpa '@'
 
     INVALID,
     END_OF_FILE
@@ -53,6 +56,7 @@ struct Token {
 inline std::string tokenTypeToString(TokenType type) {
     switch (type) {
         case TokenType::DOUBLE_LITERAL: return "DOUBLE_LITERAL";
+        case TokenType::FLOAT_LITERAL: return "FLOAT_LITERAL";
         case TokenType::INT_LITERAL: return "INT_LITERAL";
         case TokenType::STRING_LITERAL: return "STRING_LITERAL";
         case TokenType::BOOLEAN_LITERAL: return "BOOLEAN_LITERAL";
@@ -60,6 +64,8 @@ inline std::string tokenTypeToString(TokenType type) {
         case TokenType::TYPE: return "TYPE";
         
         case TokenType::VAR: return "VAR";
+        case TokenType::CONST: return "CONST";
+        case TokenType::COMPTIME: return "COMPTIME";
         case TokenType::PRINT: return "PRINT";
         case TokenType::IF: return "IF";
         case TokenType::ELIF: return "ELIF";
@@ -88,6 +94,7 @@ inline std::string tokenTypeToString(TokenType type) {
 
         case TokenType::STRUCT: return "STRUCT";
         case TokenType::DOT: return "DOT";
+        case TokenType::ANNOTATION: return "ANNOTATION";
 
         case TokenType::INVALID: return "INVALID";
         case TokenType::END_OF_FILE: return "END_OF_FILE";
@@ -1,17 +1,33 @@
 #include "../include/CodeGen.hpp"
+#include "../include/ConstantFolder.hpp"
+#include "../include/DeadCode.hpp"
 #include "../src/runtime/runtime.hpp"
 
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Host.h>
 
 
-CodeGen::CodeGen(const std::shared_ptr<ProgramStmt>& ast_tree)
+
+CodeGen::CodeGen(const std::shared_ptr<ProgramStmt>& ast_tree, bool keepUnused)
     : builder(context), ast_tree(std::move(ast_tree)) {
     module = std::make_unique<llvm::Module>("aiko", context);
+    strType = llvm::StructType::create(context, {builder.getInt8PtrTy(), builder.getInt64Ty()}, "str");
+
+    // IR dijalankan di mesin yang sama, lebar vector mengikuti CPU host
+    llvm::StringMap<bool> features;
+    if(llvm::sys::getHostCPUFeatures(features)){
+        if(features.lookup("avx512f")) vectorBytes = 64;
+        else if(features.lookup("avx")) vectorBytes = 32;
+    }
+    ConstantFolder().run(this->ast_tree);
+    if(!keepUnused) DeadCodeEliminator().run(this->ast_tree);
     makeMainFunction();
 }
 
 
 
 void CodeGen::generateProgram(const std::shared_ptr<ProgramStmt>& ast_tree){
+    collectWrittenNames(ast_tree);
     enterScope(); // push stack pertama
     for(const auto& stmt: ast_tree->statements) generateStatement(stmt);
     exitScope();
@@ -29,6 +45,7 @@ void CodeGen::generateStatement(const std::shared_ptr<Stmt>& stmt){
     else if(stmt->type == StmtType::VarDecl){
         auto varDeclStmt = std::static_pointer_cast<VarDeclStmt>(stmt);
         handleVarDeclaration(varDeclStmt);
+        markReadOnlyGlobal(varDeclStmt);
     }
     else if(stmt->type == StmtType::Assignment){
         auto assignmentStmt = std::static_pointer_cast<AssignmentStmt>(stmt);
@@ -64,6 +81,9 @@ void CodeGen::generateStatement(const std::shared_ptr<Stmt>& stmt){
     else if(stmt->type == StmtType::Return){
         auto ret = std::static_pointer_cast<ReturnStmt>(stmt);
         handleReturn(ret);
+        // sama seperti break: statement setelah return (mis. br ke if_merge) masuk block baru
+        llvm::BasicBlock *contBB = llvm::BasicBlock::Create(context, "after_return", builder.GetInsertBlock()->getParent());
+        builder.SetInsertPoint(contBB);
     }
     else if(stmt->type == StmtType::StructDecl){
         auto structStmt = std::static_pointer_cast<StructStmt>(stmt);
@@ -118,6 +138,10 @@ llvm::Value* CodeGen::generateExpression(std::shared_ptr<Stmt> expr) {
         auto memberStmt = std::static_pointer_cast<MemberAccessExpr>(expr);
         return generateMemberAccess(memberStmt);
     }
+    else if(expr->type == StmtType::DynArrayNew){
+        auto dynStmt = std::static_pointer_cast<DynArrayExpr>(expr);
+        return generateDynArray(dynStmt);
+    }
     return nullptr;
 }
 
@@ -154,6 +178,56 @@ llvm::AllocaInst* CodeGen::createEntryBlockAlloca(
     return tmpB.CreateAlloca(type, arraySize, varName.c_str());
 }
 
+// variabel top-level main jadi global internal: terlihat dari function dan nilai awal konstan
+// langsung berada di .data (tanpa store saat startup). variabel lain tetap alloca di entry block
+llvm::Value* CodeGen::createVariableStorage(const std::string& name, llvm::Type* type){
+    llvm::Function* func = builder.GetInsertBlock()->getParent();
+    llvm::Align align = type->isArrayTy() ? llvm::Align(vectorBytes) : module->getDataLayout().getPrefTypeAlign(type);
+    if(func != mainFun || VariablesStack.size() != 1){
+        llvm::AllocaInst* alloc = createEntryBlockAlloca(func, name, type);
+        if(type->isArrayTy()) alloc->setAlignment(align); // load/store vector elementwise bisa aligned
+        return alloc;
+    }
+    auto* global = new llvm::GlobalVariable(*module, type, false, llvm::GlobalValue::InternalLinkage,
+                                            llvm::Constant::getNullValue(type), name);
+    global->setAlignment(align);
+    return global;
+}
+
+// nilai konstan untuk global top-level cukup jadi initializer-nya, selain itu store biasa
+void CodeGen::storeInitialValue(llvm::Value* storage, llvm::Value* value){
+    auto* global = llvm::dyn_cast<llvm::GlobalVariable>(storage);
+    auto* constant = llvm::dyn_cast<llvm::Constant>(value);
+    if(global && constant){
+        global->setInitializer(constant);
+        return;
+    }
+    builder.CreateStore(value, storage);
+}
+
+// nama yang isinya bisa berubah setelah deklarasi: target assignment, variabel loop, array yang
+// dikirim ke function user / builtin yang menulis (load, push, ...). global top-level yang namanya
+// tidak ada di sini ditandai constant, llvm bisa membaca isinya saat compile
+void CodeGen::collectWrittenNames(const std::shared_ptr<Stmt>& stmt){
+    static const std::set<std::string> readOnlyBuiltins = {
+        "len", "shape", "save", "sum", "sum_fast", "min", "max", "dot", "dot_fast", "argmin", "argmax",
+        "count", "any", "all", "and", "or", "xor", "slice", "substr", "find", "split", "starts_with", "ends_with",
+        "popcount", "clz", "ctz", "bswap", "rotl", "rotr"};
+    if(stmt->type == StmtType::Assignment) WrittenNames.insert(std::static_pointer_cast<AssignmentStmt>(stmt)->name);
+    if(stmt->type == StmtType::For) WrittenNames.insert(std::static_pointer_cast<ForStmt>(stmt)->var_name);
+    if(stmt->type == StmtType::VarDecl){
+        auto init = std::dynamic_pointer_cast<IdentifierStmt>(std::static_pointer_cast<VarDeclStmt>(stmt)->initializer);
+        if(init) WrittenNames.insert(init->name); // var b = a: b bisa berbagi isi dengan a
+    }
+    if(stmt->type == StmtType::FunctionCall){
+        auto call = std::static_pointer_cast<FunctionCallStmt>(stmt);
+        if(!readOnlyBuiltins.count(call->name))
+            for(const auto& arg : call->args)
+                if(auto id = std::dynamic_pointer_cast<IdentifierStmt>(arg)) WrittenNames.insert(id->name);
+    }
+    forEachChild(stmt, [this](const std::shared_ptr<Stmt>& child){ collectWrittenNames(child); });
+}
+
 
 
 void CodeGen::enterScope() { VariablesStack.push_back({}); }
@@ -166,6 +240,10 @@ VarInfo* CodeGen::lookupVariable(const std::string& name) {
         auto found = it->find(name);
         if (found != it->end()) {
             // std::cout << found->first << "\n";
+            // alloca milik function lain (variabel di dalam blok main) tidak terlihat dari function,
+            // hanya variabel top-level (global) yang bisa dipakai bersama
+            auto* alloc = llvm::dyn_cast<llvm::AllocaInst>(found->second.alloc);
+            if (alloc && builder.GetInsertBlock() && alloc->getFunction() != builder.GetInsertBlock()->getParent()) return nullptr;
             return &found->second;
         }
     }
@@ -183,22 +261,355 @@ void CodeGen::run(bool printIr){
 
 
 
-size_t CodeGen::sizeofArray(const std::shared_ptr<ArrayLiteralStmt>& arrStmt){
-    return arrStmt->elements.size();
+// ukuran tiap dimensi literal bersarang, semua baris harus sama panjang
+std::vector<size_t> CodeGen::arrayLiteralShape(const std::shared_ptr<ArrayLiteralStmt>& arrStmt){
+    if(arrStmt->elements.empty()) throw std::runtime_error("Array tidak boleh kosong");
+
+    std::vector<size_t> shape = { arrStmt->elements.size() };
+    auto first = std::dynamic_pointer_cast<ArrayLiteralStmt>(arrStmt->elements[0]);
+    if(!first) return shape;
+
+    std::vector<size_t> inner = arrayLiteralShape(first);
+    for(const auto& el : arrStmt->elements){
+        auto row = std::dynamic_pointer_cast<ArrayLiteralStmt>(el);
+        if(!row || arrayLiteralShape(row) != inner)
+            throw std::runtime_error("Array rows must all have the same shape");
+    }
+    shape.insert(shape.end(), inner.begin(), inner.end());
+    return shape;
+}
+
+
+
+// helper array: tipe elemen, pointer ke elemen pertama, dan jumlah elemen (i64)
+// array biasa ukurannya konstan, array dinamis dibaca dari header saat runtime
+llvm::Type* CodeGen::getArrayElementType(const VarInfo* var){
+    if(isBitArray(var)) return builder.getInt1Ty(); // datanya word i64, tiap elemen 1 bit
+    if(var->dataType == LiteralType::STRUCT) return StructTypes.at(var->structTypeName).type; // @soa: datanya blok kolom
+    if(var->isDynamic)
+        return llvm::cast<llvm::StructType>(var->storageType())->getElementType(0)->getPointerElementType();
+    return llvm::cast<llvm::ArrayType>(var->storageType())->getElementType();
+}
+
+// array bool disimpan rapat: 64 elemen per word i64, elemen ke-i = bit (i % 64) dari word (i / 64)
+bool CodeGen::isBitArray(const VarInfo* var){
+    return var->isArray && var->dataType == LiteralType::BOOL;
+}
+
+// jumlah word i64 untuk len bit
+llvm::Value* CodeGen::bitWordCount(llvm::Value* len){
+    return builder.CreateLShr(builder.CreateAdd(len, builder.getInt64(63)), 6, "words");
+}
+
+llvm::Value* CodeGen::getArrayDataPtr(const VarInfo* var){
+    if(var->isDynamic){
+        llvm::Type* headerTy = var->storageType();
+        llvm::Value* dataField = builder.CreateStructGEP(headerTy, var->alloc, 0);
+        return builder.CreateLoad(dataField->getType()->getPointerElementType(), dataField, "arr_data");
+    }
+    llvm::Value* zero = llvm::ConstantInt::get(builder.getInt32Ty(), 0);
+    return builder.CreateGEP(var->storageType(), var->alloc, {zero, zero}, "arr_data");
+}
+
+llvm::Value* CodeGen::getArrayLength(const VarInfo* var){
+    if(var->isDynamic){
+        llvm::Value* lenField = builder.CreateStructGEP(var->storageType(), var->alloc, 1);
+        return builder.CreateLoad(builder.getInt64Ty(), lenField, "arr_len");
+    }
+    return llvm::ConstantInt::get(builder.getInt64Ty(), var->size);
+}
+
+// jumlah dimensi, array dinamis multi dimensi menyimpan ukuran tiap dimensi di field ke-3 header
+size_t CodeGen::getArrayRank(const VarInfo* var){
+    if(var->isDynamic){
+        auto headerTy = llvm::cast<llvm::StructType>(var->storageType());
+        return headerTy->getNumElements() > 3 ? llvm::cast<llvm::ArrayType>(headerTy->getElementType(3))->getNumElements() : 1;
+    }
+    return var->shape.empty() ? 1 : var->shape.size();
+}
+
+// ukuran dimensi ke-dim (i64)
+llvm::Value* CodeGen::getArrayDim(const VarInfo* var, size_t dim){
+    if(var->isDynamic){
+        if(getArrayRank(var) == 1) return getArrayLength(var);
+        llvm::Type* headerTy = var->storageType();
+        llvm::Value* dimPtr = builder.CreateInBoundsGEP(headerTy, var->alloc,
+            {builder.getInt32(0), builder.getInt32(3), builder.getInt32(dim)}, "dimptr");
+        return builder.CreateLoad(builder.getInt64Ty(), dimPtr, "dim");
+    }
+    size_t extent = var->shape.empty() ? var->size : var->shape[dim];
+    return llvm::ConstantInt::get(builder.getInt64Ty(), extent);
+}
+
+// header array dinamis: { T* data, i64 len, i64 cap } (+ [rank x i64] ukuran dimensi kalau multi dimensi)
+llvm::StructType* CodeGen::getDynArrayType(llvm::Type* elemTy, size_t rank){
+    std::vector<llvm::Type*> fields = {elemTy->getPointerTo(), builder.getInt64Ty(), builder.getInt64Ty()};
+    if(rank > 1) fields.push_back(llvm::ArrayType::get(builder.getInt64Ty(), rank));
+    return llvm::StructType::get(context, fields);
+}
+
+// struct kecil (<= 16 byte, dua register di ABI x86-64 / AArch64) dikirim dan dikembalikan by value,
+// yang lebih besar lewat pointer
+bool CodeGen::structInRegisters(llvm::StructType* structTy){
+    return module->getDataLayout().getTypeAllocSize(structTy).getFixedSize() <= 16;
+}
+
+// nama struct user kalau val pointer ke struct itu (variabel struct, struct literal, hasil function)
+std::string CodeGen::structNameOf(llvm::Value* val){
+    if(!val->getType()->isPointerTy()) return "";
+    llvm::Type* pointee = val->getType()->getPointerElementType();
+    for(const auto& [name, info] : StructTypes)
+        if(info.type == pointee) return name;
+    return "";
+}
+
+// alamat struct dari ekspresi: p, p.pos (struct di dalam struct), atau ekspresi yang menghasilkan struct
+llvm::Value* CodeGen::structPointer(const std::shared_ptr<Stmt>& expr, std::string& structName){
+    if(expr->type == StmtType::Identifier){
+        const std::string& name = std::static_pointer_cast<IdentifierStmt>(expr)->name;
+        VarInfo* var = lookupVariable(name);
+        if(!var) throw std::runtime_error("Variable not found: " + name);
+        if(var->structTypeName.empty() || var->isArray) throw std::runtime_error("Variable is not a struct: " + name);
+        structName = var->structTypeName;
+        return var->alloc;
+    }
+    if(expr->type == StmtType::MemberAccess){
+        auto member = std::static_pointer_cast<MemberAccessExpr>(expr);
+        std::string ownerName;
+        llvm::Value* fieldPtr = memberPointer(member->object, member->memberName, ownerName);
+        StructInfo& info = StructTypes.at(ownerName);
+        if(!info.fieldStructs.count(member->memberName)) throw std::runtime_error(member->memberName + " is not a struct");
+        structName = info.fieldStructs.at(member->memberName);
+        return fieldPtr;
+    }
+    llvm::Value* val = generateExpression(expr);
+    structName = structNameOf(val);
+    if(structName.empty()) throw std::runtime_error("Expression is not a struct");
+    return val;
+}
+
+// alamat object.field, object bisa variabel struct, field struct (a.b), atau elemen array struct (pts[i]).
+// elemen array struct langsung ke field-nya, jadi @soa hanya menyentuh kolom field itu
+llvm::Value* CodeGen::memberPointer(const std::shared_ptr<Stmt>& object, const std::string& fieldName, std::string& structName){
+    if(object->type == StmtType::ArrayAccess){
+        auto access = std::static_pointer_cast<ArrayAccessStmt>(object);
+        VarInfo* var = lookupVariable(access->array_name);
+        if(var && var->isArray && var->dataType == LiteralType::STRUCT){
+            std::vector<llvm::Value*> indices;
+            for(const auto& idx : access->indices) indices.push_back(generateExpression(idx));
+            structName = var->structTypeName;
+            return structArrayField(var, generateArrayIndex(var, indices), fieldName);
+        }
+    }
+    llvm::Value* base = structPointer(object, structName);
+    StructInfo& info = StructTypes.at(structName);
+    auto field = info.fieldIndices.find(fieldName);
+    if(field == info.fieldIndices.end()) throw std::runtime_error("Unknown field: " + fieldName);
+    return builder.CreateStructGEP(info.type, base, field->second, fieldName + "_ptr");
+}
+
+// array struct: biasa = array of struct (elemen berurutan), @soa = satu blok berisi kolom per field
+// [f0 x cap][f1 x cap]..., kolom ke-k mulai di cap * (ukuran field 0..k-1). cap kelipatan 8 supaya semua kolom align
+bool CodeGen::isSoaArray(const VarInfo* var){
+    return var->isArray && var->dataType == LiteralType::STRUCT && StructTypes.at(var->structTypeName).soa;
+}
+
+// pointer ke elemen pertama kolom field ke-field
+llvm::Value* CodeGen::soaColumn(const VarInfo* var, unsigned field){
+    llvm::StructType* structTy = StructTypes.at(var->structTypeName).type;
+    const llvm::DataLayout& layout = module->getDataLayout();
+    uint64_t before = 0;
+    for(unsigned k = 0; k < field; k++) before += layout.getTypeAllocSize(structTy->getElementType(k)).getFixedSize();
+
+    llvm::Value* block = getArrayDataPtr(var);
+    llvm::Value* capField = builder.CreateStructGEP(var->storageType(), var->alloc, 2);
+    llvm::Value* cap = builder.CreateLoad(builder.getInt64Ty(), capField, "soa_cap");
+    llvm::Value* start = builder.CreateInBoundsGEP(builder.getInt8Ty(), block, builder.CreateMul(cap, builder.getInt64(before), "", true, true));
+    return builder.CreateBitCast(start, structTy->getElementType(field)->getPointerTo(), "soa_col");
+}
+
+// alamat field elemen ke-idx (idx sudah dicek batasnya)
+llvm::Value* CodeGen::structArrayField(const VarInfo* var, llvm::Value* idx, const std::string& fieldName){
+    StructInfo& info = StructTypes.at(var->structTypeName);
+    auto field = info.fieldIndices.find(fieldName);
+    if(field == info.fieldIndices.end()) throw std::runtime_error("Unknown field: " + fieldName);
+    if(info.soa)
+        return builder.CreateInBoundsGEP(info.type->getElementType(field->second), soaColumn(var, field->second), idx, fieldName + "_ptr");
+    return builder.CreateInBoundsGEP(info.type, getArrayDataPtr(var), {idx, builder.getInt32(field->second)}, fieldName + "_ptr");
+}
+
+// elemen utuh sebagai nilai struct, @soa dikumpulkan dari tiap kolom
+llvm::Value* CodeGen::loadStructElement(const VarInfo* var, llvm::Value* idx){
+    llvm::StructType* structTy = StructTypes.at(var->structTypeName).type;
+    if(!isSoaArray(var)) return builder.CreateLoad(structTy, builder.CreateInBoundsGEP(structTy, getArrayDataPtr(var), idx));
+    llvm::Value* value = llvm::UndefValue::get(structTy);
+    for(unsigned k = 0; k < structTy->getNumElements(); k++){
+        llvm::Type* fieldTy = structTy->getElementType(k);
+        llvm::Value* fieldVal = builder.CreateLoad(fieldTy, builder.CreateInBoundsGEP(fieldTy, soaColumn(var, k), idx));
+        value = builder.CreateInsertValue(value, fieldVal, k);
+    }
+    return value;
+}
+
+void CodeGen::storeStructElement(const VarInfo* var, llvm::Value* idx, llvm::Value* value){
+    llvm::StructType* structTy = StructTypes.at(var->structTypeName).type;
+    if(!isSoaArray(var)){
+        builder.CreateStore(value, builder.CreateInBoundsGEP(structTy, getArrayDataPtr(var), idx));
+        return;
+    }
+    for(unsigned k = 0; k < structTy->getNumElements(); k++){
+        llvm::Type* fieldTy = structTy->getElementType(k);
+        builder.CreateStore(builder.CreateExtractValue(value, k), builder.CreateInBoundsGEP(fieldTy, soaColumn(var, k), idx));
+    }
+}
+
+// jumlah lane per vector SIMD, ditentukan elemen terlebar yang ikut dihitung (bool = 1 byte)
+unsigned CodeGen::vectorLanes(const std::vector<llvm::Type*>& elemTypes){
+    uint64_t widest = 1;
+    for(llvm::Type* ty : elemTypes)
+        if(!ty->isIntegerTy(1)) widest = std::max<uint64_t>(widest, module->getDataLayout().getTypeStoreSize(ty).getFixedSize());
+    return std::max<uint64_t>(1, vectorBytes / widest);
+}
+
+// baca vf elemen mulai idx (vf = 1 -> skalar). bool disimpan 1 byte per elemen,
+// jadi vector bool dibaca sebagai <vf x i8> lalu di-trunc
+llvm::Value* CodeGen::loadArrayLanes(const VarInfo* var, llvm::Value* data, llvm::Value* idx, unsigned vf){
+    if(isBitArray(var)){
+        // vf bit berurutan selalu di dalam satu word (idx kelipatan vf, vf <= 64)
+        llvm::Value* word = builder.CreateLoad(builder.getInt64Ty(), builder.CreateInBoundsGEP(builder.getInt64Ty(), data, builder.CreateLShr(idx, 6)));
+        llvm::Value* bits = builder.CreateLShr(word, builder.CreateAnd(idx, 63), "bits");
+        if(vf == 1) return builder.CreateTrunc(bits, builder.getInt1Ty());
+        return builder.CreateBitCast(builder.CreateTrunc(bits, builder.getIntNTy(vf)), llvm::FixedVectorType::get(builder.getInt1Ty(), vf));
+    }
+    llvm::Type* elemTy = getArrayElementType(var);
+    llvm::Value* ptr = builder.CreateInBoundsGEP(elemTy, data, idx);
+    if(vf == 1) return markUnsigned(builder.CreateLoad(elemTy, ptr), isUnsignedType(var->dataType));
+
+    llvm::Type* vecTy = llvm::FixedVectorType::get(elemTy, vf);
+    // alloca statis aligned ke lebar vector, data arena 16 byte
+    uint64_t base = var->isDynamic ? 16 : var->storageAlign();
+    uint64_t align = std::min<uint64_t>(base, module->getDataLayout().getTypeStoreSize(vecTy).getFixedSize());
+    llvm::Value* vec = builder.CreateAlignedLoad(vecTy, builder.CreateBitCast(ptr, vecTy->getPointerTo()), llvm::Align(align));
+    return markUnsigned(vec, isUnsignedType(var->dataType));
+}
+
+// kebalikan loadArrayLanes, val sudah bertipe elemen (skalar atau vector)
+void CodeGen::storeArrayLanes(const VarInfo* var, llvm::Value* data, llvm::Value* idx, llvm::Value* val){
+    if(isBitArray(var)){
+        // baca word, ganti vf bit di posisinya, tulis lagi
+        unsigned vf = val->getType()->isVectorTy() ? llvm::cast<llvm::FixedVectorType>(val->getType())->getNumElements() : 1;
+        llvm::Value* bits = vf == 1 ? val : builder.CreateBitCast(val, builder.getIntNTy(vf));
+        llvm::Value* shift = builder.CreateAnd(idx, 63);
+        llvm::Value* mask = builder.CreateShl(builder.getInt64(vf == 64 ? ~uint64_t(0) : (uint64_t(1) << vf) - 1), shift);
+        llvm::Value* ptr = builder.CreateInBoundsGEP(builder.getInt64Ty(), data, builder.CreateLShr(idx, 6));
+        llvm::Value* word = builder.CreateLoad(builder.getInt64Ty(), ptr);
+        word = builder.CreateOr(builder.CreateAnd(word, builder.CreateNot(mask)), builder.CreateShl(builder.CreateZExt(bits, builder.getInt64Ty()), shift));
+        builder.CreateStore(word, ptr);
+        return;
+    }
+    llvm::Type* elemTy = getArrayElementType(var);
+    llvm::Value* ptr = builder.CreateInBoundsGEP(elemTy, data, idx);
+    if(!val->getType()->isVectorTy()){
+        builder.CreateStore(val, ptr);
+        return;
+    }
+    uint64_t base = var->isDynamic ? 16 : var->storageAlign();
+    uint64_t align = std::min<uint64_t>(base, module->getDataLayout().getTypeStoreSize(val->getType()).getFixedSize());
+    builder.CreateAlignedStore(val, builder.CreateBitCast(ptr, val->getType()->getPointerTo()), llvm::Align(align));
+}
+
+// loop i64 dari begin sampai end (eksklusif), naik step per iterasi.
+// nilai 'carried' (misal akumulator) dibawa antar iterasi lewat phi, hasil akhirnya dikembalikan
+std::vector<llvm::Value*> CodeGen::emitCountedLoop(
+    llvm::Value* begin, llvm::Value* end, uint64_t step, const std::string& name,
+    const std::vector<llvm::Value*>& init,
+    const std::function<std::vector<llvm::Value*>(llvm::Value*, const std::vector<llvm::Value*>&)>& body
+){
+    llvm::Function* func = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* preBB = builder.GetInsertBlock();
+    llvm::BasicBlock* condBB = llvm::BasicBlock::Create(context, name + "_cond", func);
+    llvm::BasicBlock* bodyBB = llvm::BasicBlock::Create(context, name + "_body", func);
+    llvm::BasicBlock* endBB = llvm::BasicBlock::Create(context, name + "_end", func);
+    builder.CreateBr(condBB);
+
+    builder.SetInsertPoint(condBB);
+    llvm::PHINode* idx = builder.CreatePHI(builder.getInt64Ty(), 2, name + "_i");
+    idx->addIncoming(begin, preBB);
+    std::vector<llvm::PHINode*> phis;
+    std::vector<llvm::Value*> carried;
+    for(llvm::Value* v : init){
+        llvm::PHINode* phi = builder.CreatePHI(v->getType(), 2);
+        phi->addIncoming(v, preBB);
+        phis.push_back(phi);
+        carried.push_back(phi);
+    }
+    builder.CreateCondBr(builder.CreateICmpULT(idx, end), bodyBB, endBB);
+
+    builder.SetInsertPoint(bodyBB);
+    std::vector<llvm::Value*> next = body(idx, carried);
+    llvm::BasicBlock* latchBB = builder.GetInsertBlock();
+    idx->addIncoming(builder.CreateAdd(idx, builder.getInt64(step), name + "_next", true, true), latchBB);
+    for(size_t k = 0; k < phis.size(); k++) phis[k]->addIncoming(next[k], latchBB);
+    builder.CreateBr(condBB);
+
+    builder.SetInsertPoint(endBB);
+    return carried;
+}
+
+// kalau cond true: tampilkan pesan lalu exit(1), lanjut generate di block setelahnya
+void CodeGen::genRuntimeError(llvm::Value* cond, const std::string& message){
+    llvm::Function* parentFunc = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* errorBlock = llvm::BasicBlock::Create(context, "rt_error", parentFunc);
+    llvm::BasicBlock* continueBlock = llvm::BasicBlock::Create(context, "rt_continue", parentFunc);
+    builder.CreateCondBr(cond, errorBlock, continueBlock);
+
+    builder.SetInsertPoint(errorBlock);
+    builder.CreateCall(module->getOrInsertFunction(
+        "puts", llvm::FunctionType::get(builder.getInt32Ty(), builder.getInt8PtrTy(), true)
+    ), getCString(message));
+    llvm::FunctionCallee exitFunc = module->getOrInsertFunction(
+        "exit", llvm::FunctionType::get(builder.getVoidTy(), {builder.getInt32Ty()}, false)
+    );
+    builder.CreateCall(exitFunc, { builder.getInt32(1) });
+    builder.CreateUnreachable();
+
+    builder.SetInsertPoint(continueBlock);
 }
 
 
 
 llvm::Value* CodeGen::getBracketString(bool left) {
-    static llvm::GlobalVariable* leftGlobal = nullptr;
-    static llvm::GlobalVariable* rightGlobal = nullptr;
+    return getCString(left ? "[" : "]");
+}
+
 
-    if (!leftGlobal && !rightGlobal) {
-        leftGlobal = builder.CreateGlobalString("[", "leftBracket");
-        rightGlobal = builder.CreateGlobalString("]", "rightBracket");
+
+// semua string konstan (literal, format printf, dll) lewat sini agar 1 isi = 1 global
+llvm::Constant* CodeGen::getCString(const std::string& text) {
+    llvm::GlobalVariable*& global = StringLiterals[text];
+    if (!global) {
+        llvm::Constant* data = llvm::ConstantDataArray::getString(context, text, true);
+        global = new llvm::GlobalVariable(
+            *module, data->getType(), true,
+            llvm::GlobalValue::PrivateLinkage, data, ".str"
+        );
+        global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+        global->setAlignment(llvm::Align(1));
     }
 
-    return left ? leftGlobal : rightGlobal;
+    llvm::Constant* zero = builder.getInt32(0);
+    return llvm::ConstantExpr::getInBoundsGetElementPtr(global->getValueType(), global, llvm::ArrayRef<llvm::Constant*>{zero, zero});
+}
+
+// literal str: { ptr ke global yang di-intern, panjang diketahui saat compile }
+llvm::Constant* CodeGen::getStringLiteral(const std::string& text) {
+    return llvm::ConstantStruct::get(strType, {getCString(text), builder.getInt64(text.size())});
+}
+
+llvm::Value* CodeGen::makeString(llvm::Value* ptr, llvm::Value* len) {
+    llvm::Value* str = llvm::UndefValue::get(strType);
+    str = builder.CreateInsertValue(str, ptr, 0);
+    return builder.CreateInsertValue(str, len, 1);
 }
 
 
@@ -207,31 +618,97 @@ llvm::Value* CodeGen::getBracketString(bool left) {
 
 llvm::Type* CodeGen::literalTypeToLLVM(LiteralType type) {
     switch(type) {
-        case LiteralType::INT_32: return builder.getInt32Ty();
-        case LiteralType::INT_64: return builder.getInt64Ty();
+        case LiteralType::INT_8: case LiteralType::UINT_8: return builder.getInt8Ty();
+        case LiteralType::INT_16: case LiteralType::UINT_16: return builder.getInt16Ty();
+        case LiteralType::INT_32: case LiteralType::UINT_32: return builder.getInt32Ty();
+        case LiteralType::INT_64: case LiteralType::UINT_64: return builder.getInt64Ty();
+        case LiteralType::FLOAT: return builder.getFloatTy();
         case LiteralType::DOUBLE: return builder.getDoubleTy();
         case LiteralType::BOOL: return builder.getInt1Ty();
-        case LiteralType::STRING: return builder.getInt8PtrTy();
+        case LiteralType::STRING: return strType;
         default: return builder.getInt32Ty(); // fallback
     }
 }
 
+// konversi nilai ke tipe llvm tujuan (int <-> int beda lebar, int -> float)
+// berlaku juga untuk vector dengan jumlah lane sama
+// sumber unsigned dinaikkan dengan zext / uitofp, toUnsigned = tujuannya tipe unsigned
+llvm::Value* CodeGen::castToType(llvm::Value* val, llvm::Type* ty, bool toUnsigned) {
+    llvm::Type* from = val->getType();
+    if(from == ty) return val;
+    llvm::Type* fromS = from->getScalarType();
+    llvm::Type* toS = ty->getScalarType();
+    bool fromUnsigned = fromS->isIntegerTy(1) || isUnsignedValue(val);
+    bool keepUnsigned = toUnsigned && toS->isIntegerTy() && !toS->isIntegerTy(1);
+    llvm::Value* result = nullptr;
+    if(fromS->isIntegerTy() && toS->isIntegerTy(1)) return builder.CreateICmpNE(val, llvm::Constant::getNullValue(from), "casttmp");
+    if(fromS->isIntegerTy() && toS->isIntegerTy())
+        result = fromUnsigned ? builder.CreateZExtOrTrunc(val, ty, "casttmp") : builder.CreateSExtOrTrunc(val, ty, "casttmp");
+    else if(fromS->isIntegerTy() && toS->isFloatingPointTy())
+        result = fromUnsigned ? builder.CreateUIToFP(val, ty, "casttmp") : builder.CreateSIToFP(val, ty, "casttmp");
+    else if(fromS->isFloatingPointTy() && toS->isFloatingPointTy()) result = builder.CreateFPCast(val, ty, "casttmp");
+    else if(fromS->isFloatingPointTy() && toS->isIntegerTy())
+        result = toUnsigned ? builder.CreateFPToUI(val, ty, "casttmp") : builder.CreateFPToSI(val, ty, "casttmp");
+    else throw std::runtime_error("Cannot convert value to the target type");
+    return markUnsigned(result, keepUnsigned);
+}
+
+// tandai nilai bertipe unsigned, dipakai operasi berikutnya (udiv, icmp ult, zext, print)
+llvm::Value* CodeGen::markUnsigned(llvm::Value* val, bool isUnsigned) {
+    if(isUnsigned && !llvm::isa<llvm::Constant>(val)) UnsignedValues.insert(val);
+    return val;
+}
+
+bool CodeGen::isUnsignedValue(llvm::Value* val) {
+    return UnsignedValues.count(val) > 0;
+}
+
+LiteralType CodeGen::valueLiteralType(llvm::Value* val) {
+    return inferLiteralTypeFromLLVM(val->getType(), isUnsignedValue(val));
+}
+
+// literal angka tanpa tipe ikut tipe pasangannya: x * 2.5 dengan x f32 tetap f32,
+// b + 1 dengan b i64 tetap i64. int hanya diubah kalau nilainya muat di tipe tujuan.
+// literal hasil folding tidak ikut (tipenya sama dengan ekspresi / variabel asalnya)
+llvm::Value* CodeGen::adaptLiteral(const std::shared_ptr<Stmt>& expr, llvm::Value* val, llvm::Type* ty, bool toUnsigned) {
+    std::shared_ptr<Stmt> e = expr;
+    if(e->type == StmtType::UnaryOp && std::static_pointer_cast<UnaryOpStmt>(e)->op == "-")
+        e = std::static_pointer_cast<UnaryOpStmt>(e)->operand;
+    if(e->type != StmtType::Literal || std::static_pointer_cast<LiteralStmt>(e)->folded) return val;
+
+    llvm::Type* target = ty->getScalarType();
+    llvm::Type* from = val->getType();
+    if(from == target) return val;
+    if(from->isFloatingPointTy() && target->isFloatingPointTy()) return castToType(val, target);
+    auto constInt = llvm::dyn_cast<llvm::ConstantInt>(val);
+    if(!constInt || from->isIntegerTy(1) || !target->isIntegerTy() || target->isIntegerTy(1)) return val;
+    const llvm::APInt& v = constInt->getValue();
+    unsigned width = target->getIntegerBitWidth();
+    bool fits = toUnsigned ? !v.isNegative() && v.getActiveBits() <= width : v.getMinSignedBits() <= width;
+    return fits ? castToType(val, target) : val;
+}
+
 llvm::Constant* CodeGen::defaultValueForType(LiteralType type) {
     switch(type) {
-        case LiteralType::INT_32: return llvm::ConstantInt::get(builder.getInt32Ty(), 0);
-        case LiteralType::INT_64: return llvm::ConstantInt::get(builder.getInt64Ty(), 0);
+        case LiteralType::INT_8: case LiteralType::INT_16: case LiteralType::INT_32: case LiteralType::INT_64:
+        case LiteralType::UINT_8: case LiteralType::UINT_16: case LiteralType::UINT_32: case LiteralType::UINT_64:
+            return llvm::ConstantInt::get(literalTypeToLLVM(type), 0);
+        case LiteralType::FLOAT: return llvm::ConstantFP::get(builder.getFloatTy(), 0.0);
         case LiteralType::DOUBLE: return llvm::ConstantFP::get(builder.getDoubleTy(), 0.0);
         case LiteralType::BOOL: return llvm::ConstantInt::get(builder.getInt1Ty(), 0);
-        case LiteralType::STRING: return llvm::ConstantPointerNull::get(builder.getInt8PtrTy());
+        case LiteralType::STRING: return getStringLiteral("");
         default: return llvm::ConstantInt::get(builder.getInt32Ty(), 0);
     }
 }
 
-LiteralType CodeGen::inferLiteralTypeFromLLVM(llvm::Type* t) {
-    if(t->isIntegerTy(32)) return LiteralType::INT_32;
-    if(t->isIntegerTy(64)) return LiteralType::INT_64;
+LiteralType CodeGen::inferLiteralTypeFromLLVM(llvm::Type* t, bool isUnsigned) {
+    if(t->isIntegerTy(8)) return isUnsigned ? LiteralType::UINT_8 : LiteralType::INT_8;
+    if(t->isIntegerTy(16)) return isUnsigned ? LiteralType::UINT_16 : LiteralType::INT_16;
+    if(t->isIntegerTy(32)) return isUnsigned ? LiteralType::UINT_32 : LiteralType::INT_32;
+    if(t->isIntegerTy(64)) return isUnsigned ? LiteralType::UINT_64 : LiteralType::INT_64;
     if(t->isIntegerTy(1)) return LiteralType::BOOL;
+    if(t->isFloatTy()) return LiteralType::FLOAT;
     if(t->isDoubleTy()) return LiteralType::DOUBLE;
-    if(t->isPointerTy() && t->getPointerElementType()->isIntegerTy(8)) return LiteralType::STRING;
+    if(t == strType) return LiteralType::STRING;
     return LiteralType::UNKNOWN;
 }
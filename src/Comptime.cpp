@@ -0,0 +1,772 @@
+#include "../include/Comptime.hpp"
+#include <cmath>
+#include <climits>
+
+// batas langkah interpreter, supaya loop tak berujung di comptime tidak membuat compile hang
+static const uint64_t COMPTIME_STEP_LIMIT = 100000000;
+static const size_t COMPTIME_CALL_DEPTH = 1000;
+
+static bool isIntType(LiteralType t){
+    switch(t){
+        case LiteralType::INT_8: case LiteralType::INT_16: case LiteralType::INT_32: case LiteralType::INT_64:
+        case LiteralType::UINT_8: case LiteralType::UINT_16: case LiteralType::UINT_32: case LiteralType::UINT_64:
+            return true;
+        default: return false;
+    }
+}
+
+static bool isFloatType(LiteralType t){ return t == LiteralType::FLOAT || t == LiteralType::DOUBLE; }
+
+static unsigned widthOf(LiteralType t){
+    switch(t){
+        case LiteralType::INT_8: case LiteralType::UINT_8: return 8;
+        case LiteralType::INT_16: case LiteralType::UINT_16: return 16;
+        case LiteralType::INT_32: case LiteralType::UINT_32: return 32;
+        default: return 64;
+    }
+}
+
+static LiteralType intType(unsigned width, bool isUnsigned){
+    switch(width){
+        case 8: return isUnsigned ? LiteralType::UINT_8 : LiteralType::INT_8;
+        case 16: return isUnsigned ? LiteralType::UINT_16 : LiteralType::INT_16;
+        case 32: return isUnsigned ? LiteralType::UINT_32 : LiteralType::INT_32;
+        default: return isUnsigned ? LiteralType::UINT_64 : LiteralType::INT_64;
+    }
+}
+
+// potong ke lebar tipe: signed disimpan sign-extend, unsigned zero-extend (u64 = bit apa adanya)
+static int64_t normalizeInt(int64_t v, LiteralType t){
+    switch(t){
+        case LiteralType::INT_8: return static_cast<int8_t>(v);
+        case LiteralType::INT_16: return static_cast<int16_t>(v);
+        case LiteralType::INT_32: return static_cast<int32_t>(v);
+        case LiteralType::UINT_8: return static_cast<uint8_t>(v);
+        case LiteralType::UINT_16: return static_cast<uint16_t>(v);
+        case LiteralType::UINT_32: return static_cast<uint32_t>(v);
+        case LiteralType::BOOL: return v != 0;
+        default: return v;
+    }
+}
+
+static ComptimeValue intValue(LiteralType t, int64_t v){
+    ComptimeValue value;
+    value.type = t;
+    value.i = normalizeInt(v, t);
+    return value;
+}
+
+static ComptimeValue floatValue(LiteralType t, double v){
+    ComptimeValue value;
+    value.type = t;
+    value.f = t == LiteralType::FLOAT ? static_cast<float>(v) : v;
+    return value;
+}
+
+// sama dengan promoteBinaryType + aturan unsigned emitBinaryOp
+static LiteralType promoteTypes(LiteralType a, LiteralType b){
+    if(isFloatType(a) || isFloatType(b))
+        return (a == LiteralType::DOUBLE || b == LiteralType::DOUBLE) ? LiteralType::DOUBLE : LiteralType::FLOAT;
+    unsigned width = std::max(widthOf(a), widthOf(b));
+    bool isUnsigned = (isUnsignedType(a) && widthOf(a) == width) || (isUnsignedType(b) && widthOf(b) == width);
+    return intType(width, isUnsigned);
+}
+
+// literal yang belum di-fold: ikut tipe pasangannya (adaptLiteral)
+static bool isRawLiteral(const std::shared_ptr<Stmt>& expr){
+    std::shared_ptr<Stmt> e = expr;
+    if(e->type == StmtType::UnaryOp && std::static_pointer_cast<UnaryOpStmt>(e)->op == "-")
+        e = std::static_pointer_cast<UnaryOpStmt>(e)->operand;
+    return e->type == StmtType::Literal && !std::static_pointer_cast<LiteralStmt>(e)->folded;
+}
+
+static void adaptLiteral(ComptimeValue& lit, LiteralType target){
+    if(lit.type == target) return;
+    if(isFloatType(lit.type) && isFloatType(target)){
+        lit = ComptimeEvaluator::castValue(lit, target);
+        return;
+    }
+    if(!isIntType(lit.type) || !isIntType(target)) return;
+    unsigned width = widthOf(target);
+    bool fits = isUnsignedType(target) ? lit.i >= 0 && (width == 64 || lit.i < (int64_t(1) << width))
+                                       : width == 64 || (lit.i >= -(int64_t(1) << (width - 1)) && lit.i < (int64_t(1) << (width - 1)));
+    if(fits) lit = ComptimeEvaluator::castValue(lit, target);
+}
+
+// struct disalin (value semantics), array tetap dipakai bersama
+static ComptimeValue ownedCopy(const ComptimeValue& value){
+    if(value.isArray || value.structName.empty() || !value.data) return value;
+    ComptimeValue copy = value;
+    copy.data = std::make_shared<ComptimeStorage>(*value.data);
+    for(auto& item : copy.data->items) item = ownedCopy(item);
+    return copy;
+}
+
+
+ComptimeEvaluator::ComptimeEvaluator(const std::map<std::string, std::shared_ptr<FunctionDeclStmt>>& functions,
+                                     const std::map<std::string, std::shared_ptr<StructStmt>>& structs)
+    : functions(functions), structs(structs) {}
+
+ComptimeValue ComptimeEvaluator::evaluate(const std::shared_ptr<Stmt>& expr){
+    scopes.assign(1, {});
+    callStack.clear();
+    steps = 0;
+    ComptimeValue value = eval(expr);
+    if(value.type == LiteralType::UNKNOWN && value.structName.empty()) fail("expression has no value");
+    return value;
+}
+
+void ComptimeEvaluator::tick(){
+    if(++steps > COMPTIME_STEP_LIMIT) fail("evaluation did not finish within " + std::to_string(COMPTIME_STEP_LIMIT) + " steps");
+}
+
+void ComptimeEvaluator::fail(const std::string& message) const {
+    throw std::runtime_error("comptime: " + message + (callStack.empty() ? "" : " (in " + callStack.back() + ")"));
+}
+
+ComptimeValue* ComptimeEvaluator::variable(const std::string& name){
+    for(auto it = scopes.rbegin(); it != scopes.rend(); ++it){
+        auto found = it->find(name);
+        if(found != it->end()) return &found->second;
+    }
+    return nullptr;
+}
+
+ComptimeValue ComptimeEvaluator::castValue(const ComptimeValue& value, LiteralType type){
+    if(value.type == type || value.isArray || !value.structName.empty()) return value;
+    bool fromInt = isIntType(value.type) || value.type == LiteralType::BOOL;
+    bool fromUnsigned = isUnsignedType(value.type) || value.type == LiteralType::BOOL;
+    if(isIntType(value.type) && type == LiteralType::BOOL) return intValue(type, value.i != 0);
+    if(fromInt && isIntType(type)) return intValue(type, value.i);
+    if(fromInt && isFloatType(type)){
+        if(type == LiteralType::FLOAT)
+            return floatValue(type, fromUnsigned ? static_cast<float>(static_cast<uint64_t>(value.i)) : static_cast<float>(value.i));
+        return floatValue(type, fromUnsigned ? static_cast<double>(static_cast<uint64_t>(value.i)) : static_cast<double>(value.i));
+    }
+    if(isFloatType(value.type) && isFloatType(type)) return floatValue(type, value.f);
+    if(isFloatType(value.type) && isIntType(type))
+        return intValue(type, isUnsignedType(type) ? static_cast<int64_t>(static_cast<uint64_t>(value.f)) : static_cast<int64_t>(value.f));
+    throw std::runtime_error("comptime: cannot convert " + literalTypeName(value.type) + " to " + literalTypeName(type));
+}
+
+ComptimeValue ComptimeEvaluator::defaultValue(LiteralType type, const std::string& structName){
+    if(!structName.empty()) return structValue(structName);
+    if(isFloatType(type)) return floatValue(type, 0);
+    ComptimeValue value;
+    value.type = type == LiteralType::UNKNOWN ? LiteralType::INT_32 : type;
+    return value;
+}
+
+ComptimeValue ComptimeEvaluator::structValue(const std::string& name){
+    auto found = structs.find(name);
+    if(found == structs.end()) fail("unknown struct " + name);
+    ComptimeValue value;
+    value.type = LiteralType::STRUCT;
+    value.structName = name;
+    value.data = std::make_shared<ComptimeStorage>();
+    for(const auto& field : found->second->fields)
+        value.data->items.push_back(defaultValue(field->type, field->structName));
+    return value;
+}
+
+size_t ComptimeEvaluator::fieldIndex(const std::string& structName, const std::string& field){
+    const auto& fields = structs.at(structName)->fields;
+    for(size_t i = 0; i < fields.size(); i++)
+        if(fields[i]->name == field) return i;
+    fail("unknown field " + field + " in " + structName);
+}
+
+ComptimeValue* ComptimeEvaluator::element(ComptimeValue& array, const std::vector<std::shared_ptr<Stmt>>& indices){
+    if(!array.isArray) fail("indexing a value that is not an array");
+    std::vector<int64_t> idx;
+    for(const auto& index : indices){
+        ComptimeValue v = eval(index);
+        if(!isIntType(v.type)) fail("array index must be an integer");
+        idx.push_back(v.i);
+    }
+    const auto& dims = array.data->dims;
+    if(idx.size() != dims.size()) fail("array has " + std::to_string(dims.size()) + " dimension(s)");
+    size_t linear = 0;
+    for(size_t d = 0; d < dims.size(); d++){
+        if(idx[d] < 0 || static_cast<uint64_t>(idx[d]) >= dims[d]) fail("index out of bounds");
+        linear = linear * dims[d] + static_cast<size_t>(idx[d]);
+    }
+    return &array.data->items[linear];
+}
+
+// tempat yang ditulis assignment: x, a[i], p.pos.x, pts[i].x
+ComptimeValue* ComptimeEvaluator::target(const std::string& name, const std::vector<std::shared_ptr<Stmt>>& indices,
+                                         const std::vector<std::string>& members){
+    ComptimeValue* slot = variable(name);
+    if(!slot) fail(name + " is not known at compile time");
+    if(!indices.empty()) slot = element(*slot, indices);
+    for(const auto& member : members){
+        if(slot->isArray || slot->structName.empty()) fail(name + " is not a struct");
+        slot = &slot->data->items[fieldIndex(slot->structName, member)];
+    }
+    return slot;
+}
+
+
+// ---------------- statement ----------------
+
+ComptimeEvaluator::Flow ComptimeEvaluator::execBlock(const std::vector<std::shared_ptr<Stmt>>& block){
+    scopes.emplace_back();
+    Flow flow = Flow::Normal;
+    for(const auto& stmt : block){
+        flow = exec(stmt);
+        if(flow != Flow::Normal) break;
+    }
+    scopes.pop_back();
+    return flow;
+}
+
+ComptimeEvaluator::Flow ComptimeEvaluator::exec(const std::shared_ptr<Stmt>& stmt){
+    tick();
+    switch(stmt->type){
+        case StmtType::VarDecl: declare(std::static_pointer_cast<VarDeclStmt>(stmt)); return Flow::Normal;
+        case StmtType::Assignment: assign(std::static_pointer_cast<AssignmentStmt>(stmt)); return Flow::Normal;
+        case StmtType::If: {
+            auto ifStmt = std::static_pointer_cast<IfStmt>(stmt);
+            auto truthy = [&](const std::shared_ptr<Stmt>& cond){
+                ComptimeValue v = eval(cond);
+                if(v.type != LiteralType::BOOL || v.isArray) fail("if condition must be a bool");
+                return v.i != 0;
+            };
+            if(truthy(ifStmt->condition)) return execBlock(ifStmt->then_block);
+            for(const auto& elif : ifStmt->elifs)
+                if(truthy(elif->condition)) return execBlock(elif->block);
+            return execBlock(ifStmt->else_block);
+        }
+        case StmtType::For: return execFor(std::static_pointer_cast<ForStmt>(stmt));
+        case StmtType::Return: {
+            auto ret = std::static_pointer_cast<ReturnStmt>(stmt);
+            returnValue = ret->value ? eval(ret->value) : ComptimeValue{};
+            return Flow::Return;
+        }
+        case StmtType::Break: return Flow::Break;
+        case StmtType::Continue: return Flow::Continue;
+        case StmtType::Print: fail("print is not allowed at compile time");
+        case StmtType::FunctionDecl: fail("functions cannot be declared inside a comptime call");
+        case StmtType::StructDecl: fail("structs cannot be declared inside a comptime call");
+        default:
+            eval(stmt); // pemanggilan function sebagai statement
+            return Flow::Normal;
+    }
+}
+
+void ComptimeEvaluator::declare(const std::shared_ptr<VarDeclStmt>& decl){
+    ComptimeValue value;
+    bool scalarType = decl->hasExplicit && decl->structName.empty();
+    if(!decl->initializer) value = defaultValue(decl->varType, decl->structName);
+    else if(decl->initializer->type == StmtType::ArrayLiteral)
+        value = evalArrayLiteral(std::static_pointer_cast<ArrayLiteralStmt>(decl->initializer), scalarType ? decl->varType : LiteralType::UNKNOWN);
+    else {
+        value = eval(decl->initializer);
+        if(value.type == LiteralType::UNKNOWN && value.structName.empty()) fail(decl->name + " is initialized without a value");
+        if(scalarType && !value.isArray) value = castValue(value, decl->varType);
+        if(!decl->structName.empty() && value.structName != decl->structName) fail(decl->name + " expects a " + decl->structName);
+    }
+    scopes.back()[decl->name] = ownedCopy(value);
+}
+
+void ComptimeEvaluator::assign(const std::shared_ptr<AssignmentStmt>& assign){
+    ComptimeValue value = eval(assign->value);
+    bool raw = isRawLiteral(assign->value);
+
+    // elemen array / field struct: ikut tipe tempatnya
+    if(!assign->indices.empty() || !assign->members.empty()){
+        ComptimeValue* slot = target(assign->name, assign->indices, assign->members);
+        if(!slot->structName.empty()){
+            if(value.structName != slot->structName) fail(assign->name + ": expected a " + slot->structName);
+            *slot = ownedCopy(value);
+        } else {
+            if(value.isArray || !value.structName.empty()) fail(assign->name + ": cannot store this value in a scalar");
+            *slot = castValue(value, slot->type);
+        }
+        return;
+    }
+
+    ComptimeValue* var = variable(assign->name);
+    if(!var) fail(assign->name + " is not known at compile time");
+    if(var->isArray){
+        if(!value.isArray) fail("elementwise array assignment is not supported at compile time");
+        *var = value;
+        return;
+    }
+    if(!var->structName.empty()){
+        if(value.structName != var->structName) fail(assign->name + " expects a " + var->structName);
+        *var = ownedCopy(value);
+        return;
+    }
+    if(raw) adaptLiteral(value, var->type);
+    if(value.type == var->type){
+        *var = value;
+        return;
+    }
+    // variabel di scope luar tetap bertipe lama, di scope sendiri boleh berganti tipe (seperti handleAssignment)
+    bool numeric = (isIntType(value.type) || isFloatType(value.type)) && (isIntType(var->type) || isFloatType(var->type));
+    bool outerScope = !scopes.back().count(assign->name);
+    if(numeric && outerScope) *var = castValue(value, var->type);
+    else scopes.back()[assign->name] = ownedCopy(value);
+}
+
+// sama dengan handleFor: index i32, berhenti saat i > end - 1
+ComptimeEvaluator::Flow ComptimeEvaluator::execFor(const std::shared_ptr<ForStmt>& forStmt){
+    auto toI32 = [&](const std::shared_ptr<Stmt>& expr){
+        ComptimeValue v = eval(expr);
+        if(!isIntType(v.type)) fail("for loop bounds must be integers");
+        switch(widthOf(v.type)){
+            case 8: return static_cast<int32_t>(static_cast<int8_t>(v.i));
+            case 16: return static_cast<int32_t>(static_cast<int16_t>(v.i));
+            default: return static_cast<int32_t>(v.i);
+        }
+    };
+    int32_t start = toI32(forStmt->start);
+    int32_t last = static_cast<int32_t>(static_cast<uint32_t>(toI32(forStmt->end)) - 1);
+    int32_t step = toI32(forStmt->step);
+
+    scopes.emplace_back();
+    scopes.back()[forStmt->var_name] = intValue(LiteralType::INT_32, start);
+    Flow flow = Flow::Normal;
+    while(true){
+        tick();
+        int32_t i = static_cast<int32_t>(castValue(scopes.back()[forStmt->var_name], LiteralType::INT_32).i);
+        if(i > last) break;
+        flow = Flow::Normal;
+        for(const auto& stmt : forStmt->block){
+            flow = exec(stmt);
+            if(flow != Flow::Normal) break;
+        }
+        if(flow == Flow::Break || flow == Flow::Return) break;
+        i = static_cast<int32_t>(castValue(scopes.back()[forStmt->var_name], LiteralType::INT_32).i);
+        scopes.back()[forStmt->var_name] = intValue(LiteralType::INT_32, static_cast<int64_t>(i) + step);
+    }
+    scopes.pop_back();
+    return flow == Flow::Return ? Flow::Return : Flow::Normal;
+}
+
+
+// ---------------- expression ----------------
+
+ComptimeValue ComptimeEvaluator::eval(const std::shared_ptr<Stmt>& expr){
+    tick();
+    switch(expr->type){
+        case StmtType::Literal: {
+            auto lit = std::static_pointer_cast<LiteralStmt>(expr);
+            ComptimeValue value;
+            value.type = lit->dataType;
+            switch(lit->dataType){
+                case LiteralType::INT_32: value.i = std::get<int32_t>(lit->value); break;
+                case LiteralType::INT_64: value.i = std::get<int64_t>(lit->value); break;
+                case LiteralType::FLOAT: case LiteralType::DOUBLE: value.f = std::get<double>(lit->value); break;
+                case LiteralType::BOOL: value.i = std::get<bool>(lit->value); break;
+                case LiteralType::STRING: value.s = std::get<std::string>(lit->value); break;
+                default: fail("unsupported literal");
+            }
+            return value;
+        }
+        case StmtType::Identifier: {
+            const std::string& name = std::static_pointer_cast<IdentifierStmt>(expr)->name;
+            ComptimeValue* var = variable(name);
+            if(!var) fail(name + " is not known at compile time");
+            return *var;
+        }
+        case StmtType::BinaryOp: {
+            auto bin = std::static_pointer_cast<BinaryOpStmt>(expr);
+            if(bin->op == "&&" || bin->op == "||"){
+                ComptimeValue cond = eval(bin->left);
+                if(cond.type != LiteralType::BOOL || cond.isArray) fail("operator " + bin->op + " needs bool operands");
+                if((cond.i != 0) == (bin->op == "||")) return cond; // sisi kanan tidak dihitung
+                ComptimeValue right = eval(bin->right);
+                if(right.type != LiteralType::BOOL || right.isArray) fail("operator " + bin->op + " needs bool operands");
+                return right;
+            }
+            ComptimeValue left = eval(bin->left);
+            ComptimeValue right = eval(bin->right);
+            return evalBinary(bin->op, left, right, isRawLiteral(bin->left), isRawLiteral(bin->right));
+        }
+        case StmtType::UnaryOp: {
+            auto unary = std::static_pointer_cast<UnaryOpStmt>(expr);
+            return evalUnary(unary->op, eval(unary->operand));
+        }
+        case StmtType::Typeof: {
+            ComptimeValue v = eval(std::static_pointer_cast<TypeofStmt>(expr)->expression);
+            if(!v.structName.empty()) fail("typeof is not supported for structs");
+            ComptimeValue name;
+            name.type = LiteralType::STRING;
+            name.s = literalTypeName(v.type);
+            return name;
+        }
+        case StmtType::ArrayLiteral: return evalArrayLiteral(std::static_pointer_cast<ArrayLiteralStmt>(expr), LiteralType::UNKNOWN);
+        case StmtType::DynArrayNew: {
+            auto dyn = std::static_pointer_cast<DynArrayExpr>(expr);
+            ComptimeValue array;
+            array.isArray = true;
+            array.type = dyn->structName.empty() ? dyn->elemType : LiteralType::STRUCT;
+            array.structName = dyn->structName;
+            array.data = std::make_shared<ComptimeStorage>();
+            size_t count = 1;
+            for(const auto& size : dyn->sizes){
+                ComptimeValue n = eval(size);
+                if(!isIntType(n.type) || n.i < 0) fail("array size must be a non-negative integer");
+                array.data->dims.push_back(static_cast<size_t>(n.i));
+                count *= static_cast<size_t>(n.i);
+            }
+            if(array.data->dims.empty()){
+                array.data->dims.push_back(0);
+                count = 0;
+            }
+            array.data->items.assign(count, defaultValue(dyn->elemType, dyn->structName));
+            for(auto& item : array.data->items) item = ownedCopy(item);
+            return array;
+        }
+        case StmtType::ArrayAccess: {
+            auto access = std::static_pointer_cast<ArrayAccessStmt>(expr);
+            ComptimeValue* var = variable(access->array_name);
+            if(!var) fail(access->array_name + " is not known at compile time");
+            if(var->type == LiteralType::STRING && !var->isArray) fail("string indexing is not supported at compile time");
+            ComptimeValue array = *var; // storage dipakai bersama, aman kalau index memanggil function
+            return *element(array, access->indices);
+        }
+        case StmtType::MemberAccess: {
+            auto member = std::static_pointer_cast<MemberAccessExpr>(expr);
+            ComptimeValue object = eval(member->object);
+            if(object.isArray || object.structName.empty()) fail("member access on a value that is not a struct");
+            return object.data->items[fieldIndex(object.structName, member->memberName)];
+        }
+        case StmtType::StructInit: {
+            auto init = std::static_pointer_cast<StructExpr>(expr);
+            ComptimeValue value = structValue(init->name);
+            for(const auto& [field, fieldExpr] : init->fieldsValue){
+                ComptimeValue& slot = value.data->items[fieldIndex(init->name, field)];
+                ComptimeValue fieldValue = eval(fieldExpr);
+                if(!slot.structName.empty()){
+                    if(fieldValue.structName != slot.structName) fail("field " + field + " expects a " + slot.structName);
+                    slot = ownedCopy(fieldValue);
+                } else {
+                    slot = castValue(fieldValue, slot.type);
+                }
+            }
+            return value;
+        }
+        case StmtType::FunctionCall: return evalCall(std::static_pointer_cast<FunctionCallStmt>(expr));
+        case StmtType::Comptime: return eval(std::static_pointer_cast<ComptimeStmt>(expr)->expression);
+        case StmtType::Input: fail("input is not allowed at compile time");
+        default: fail("expression is not supported at compile time");
+    }
+}
+
+// [1, 2, 3] / [[1, 2], [3, 4]]: tipe elemen sama dengan generateArrayLiteral
+ComptimeValue ComptimeEvaluator::evalArrayLiteral(const std::shared_ptr<ArrayLiteralStmt>& arr, LiteralType elemType){
+    ComptimeValue array;
+    array.isArray = true;
+    array.data = std::make_shared<ComptimeStorage>();
+
+    std::shared_ptr<Stmt> level = arr;
+    while(level->type == StmtType::ArrayLiteral){
+        auto lit = std::static_pointer_cast<ArrayLiteralStmt>(level);
+        array.data->dims.push_back(lit->elements.size());
+        if(lit->elements.empty()) break;
+        level = lit->elements[0];
+    }
+    std::vector<std::shared_ptr<Stmt>> leaves;
+    std::function<void(const std::shared_ptr<ArrayLiteralStmt>&, size_t)> flatten =
+        [&](const std::shared_ptr<ArrayLiteralStmt>& lit, size_t depth){
+            if(lit->elements.size() != array.data->dims[depth]) fail("array literal rows must have the same length");
+            for(const auto& el : lit->elements){
+                if(depth + 1 < array.data->dims.size()){
+                    if(el->type != StmtType::ArrayLiteral) fail("array literal rows must have the same length");
+                    flatten(std::static_pointer_cast<ArrayLiteralStmt>(el), depth + 1);
+                }
+                else leaves.push_back(el);
+            }
+        };
+    flatten(arr, 0);
+
+    std::vector<ComptimeValue> values;
+    for(const auto& leaf : leaves){
+        values.push_back(eval(leaf));
+        if(values.back().isArray || !values.back().structName.empty()) fail("array literal elements must be scalars");
+    }
+
+    LiteralType type = elemType;
+    for(size_t i = 0; type == LiteralType::UNKNOWN && i < values.size(); i++)
+        if(!isRawLiteral(leaves[i])) type = values[i].type;
+    for(size_t i = 0; type == LiteralType::UNKNOWN && i < values.size(); i++){
+        LiteralType t = values[i].type;
+        for(const auto& v : values)
+            if(v.type != t && t != LiteralType::STRING && v.type != LiteralType::STRING && t != LiteralType::BOOL && v.type != LiteralType::BOOL)
+                t = promoteTypes(t, v.type);
+        type = t;
+    }
+    for(auto& v : values){
+        if(v.type != type) v = castValue(v, type);
+    }
+    array.type = type == LiteralType::UNKNOWN ? LiteralType::INT_32 : type;
+    array.data->items = std::move(values);
+    return array;
+}
+
+ComptimeValue ComptimeEvaluator::evalCall(const std::shared_ptr<FunctionCallStmt>& call){
+    const std::string& name = call->name;
+    const auto& args = call->args;
+
+    auto fn = functions.find(name);
+    if(fn == functions.end()){
+        if(name == "len"){
+            if(args.size() != 1) fail("len expects 1 argument");
+            ComptimeValue v = eval(args[0]);
+            if(v.isArray) return intValue(LiteralType::INT_64, static_cast<int64_t>(v.data->dims[0]));
+            if(v.type == LiteralType::STRING) return intValue(LiteralType::INT_64, static_cast<int64_t>(v.s.size()));
+            fail("len expects a str or array");
+        }
+        if(name == "push" || name == "pop" || name == "reserve"){
+            if(args.empty() || args[0]->type != StmtType::Identifier) fail(name + " expects an array variable");
+            ComptimeValue* var = variable(std::static_pointer_cast<IdentifierStmt>(args[0])->name);
+            if(!var || !var->isArray) fail(name + " expects an array variable");
+            ComptimeValue array = *var;
+            if(array.data->dims.size() != 1) fail(name + " expects a one-dimensional array");
+            if(name == "reserve") return ComptimeValue{};
+            if(name == "pop"){
+                if(array.data->items.empty()) fail("pop from an empty array");
+                ComptimeValue last = array.data->items.back();
+                array.data->items.pop_back();
+                array.data->dims[0]--;
+                return last;
+            }
+            if(args.size() != 2) fail("push expects 2 arguments");
+            ComptimeValue value = eval(args[1]);
+            if(!array.structName.empty()){
+                if(value.structName != array.structName) fail("push expects a " + array.structName);
+                value = ownedCopy(value);
+            } else {
+                if(isRawLiteral(args[1])) adaptLiteral(value, array.type);
+                value = castValue(value, array.type);
+            }
+            array.data->items.push_back(value);
+            array.data->dims[0]++;
+            return ComptimeValue{};
+        }
+        if(name == "popcount" || name == "clz" || name == "ctz" || name == "bswap" || name == "rotl" || name == "rotr")
+            return evalBitBuiltin(call);
+        if(name == "print" || name == "input" || name == "save" || name == "load")
+            fail(name + " is not allowed at compile time");
+        fail("unknown function " + name + " (only user functions, len, push, pop, reserve and bit builtins run at compile time)");
+    }
+
+    const auto& decl = fn->second;
+    if(args.size() != decl->params.size())
+        fail(name + " expects " + std::to_string(decl->params.size()) + " argument(s)");
+    if(callStack.size() >= COMPTIME_CALL_DEPTH) fail("recursion deeper than " + std::to_string(COMPTIME_CALL_DEPTH) + " calls");
+
+    std::map<std::string, ComptimeValue> frame;
+    for(size_t i = 0; i < args.size(); i++){
+        auto param = std::static_pointer_cast<VarDeclStmt>(decl->params[i]);
+        ComptimeValue arg = eval(args[i]);
+        if(param->isArray){
+            if(!arg.isArray) fail(name + ": parameter " + param->name + " expects an array");
+        } else if(!param->structName.empty()){
+            if(arg.structName != param->structName) fail(name + ": parameter " + param->name + " expects a " + param->structName);
+            arg = ownedCopy(arg);
+        } else if(arg.isArray || !arg.structName.empty()){
+            fail(name + ": parameter " + param->name + " expects a scalar");
+        } else if(param->hasExplicit){
+            arg = castValue(arg, param->varType);
+        }
+        frame[param->name] = arg;
+    }
+
+    // body hanya melihat parameter dan function lain (variabel luar yang konstan sudah di-fold)
+    std::vector<std::map<std::string, ComptimeValue>> callerScopes;
+    callerScopes.swap(scopes);
+    scopes.push_back(std::move(frame));
+    callStack.push_back(name);
+    Flow flow = Flow::Normal;
+    for(const auto& stmt : decl->body){
+        flow = exec(stmt);
+        if(flow != Flow::Normal) break;
+    }
+    ComptimeValue result = flow == Flow::Return ? returnValue : ComptimeValue{};
+    callStack.pop_back();
+    scopes.swap(callerScopes);
+
+    if(decl->hasReturnType && !decl->returnsArray && decl->returnStruct.empty()){
+        if(result.type == LiteralType::UNKNOWN) return defaultValue(decl->returnType, "");
+        if(result.isArray || !result.structName.empty()) fail(name + ": return value does not match the return type");
+        return castValue(result, decl->returnType);
+    }
+    if(!decl->returnStruct.empty() && result.structName != decl->returnStruct) fail(name + " must return a " + decl->returnStruct);
+    if(decl->returnsArray && !result.isArray) fail(name + " must return an array");
+    return result;
+}
+
+// popcount / clz / ctz / bswap / rotl / rotr, hasilnya sama dengan intrinsic llvm di generateBitBuiltin
+ComptimeValue ComptimeEvaluator::evalBitBuiltin(const std::shared_ptr<FunctionCallStmt>& call){
+    const std::string& name = call->name;
+    bool rotate = name == "rotl" || name == "rotr";
+    if(call->args.size() != (rotate ? 2u : 1u))
+        fail(name + (rotate ? " expects (value, amount)" : " expects 1 integer argument"));
+    ComptimeValue x = eval(call->args[0]);
+    if(x.isArray || !isIntType(x.type)) fail(name + " expects an integer argument");
+
+    unsigned width = widthOf(x.type);
+    uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+    uint64_t u = static_cast<uint64_t>(x.i) & mask;
+    uint64_t result = 0;
+    if(name == "popcount") result = __builtin_popcountll(u);
+    else if(name == "clz") result = u == 0 ? width : __builtin_clzll(u) - (64 - width);
+    else if(name == "ctz") result = u == 0 ? width : __builtin_ctzll(u);
+    else if(name == "bswap"){
+        for(unsigned b = 0; b < width; b += 8) result = (result << 8) | ((u >> b) & 0xff);
+    }
+    else {
+        ComptimeValue amount = eval(call->args[1]);
+        if(amount.isArray || !isIntType(amount.type)) fail(name + ": amount must be an integer");
+        unsigned shift = static_cast<unsigned>(static_cast<uint64_t>(castValue(amount, x.type).i) % width);
+        if(name == "rotr") shift = (width - shift) % width;
+        result = shift == 0 ? u : ((u << shift) | (u >> (width - shift))) & mask;
+    }
+    return intValue(x.type, static_cast<int64_t>(result));
+}
+
+ComptimeValue ComptimeEvaluator::evalBinary(const std::string& op, ComptimeValue left, ComptimeValue right, bool leftRaw, bool rightRaw){
+    if(left.isArray || right.isArray || !left.structName.empty() || !right.structName.empty())
+        fail("operator " + op + " needs scalar operands at compile time");
+
+    if(left.type == LiteralType::STRING || right.type == LiteralType::STRING){
+        if(left.type != right.type || (op != "==" && op != "!=")) fail("operator " + op + " is not supported for str");
+        return intValue(LiteralType::BOOL, (left.s == right.s) == (op == "=="));
+    }
+    if(left.type == LiteralType::BOOL && right.type == LiteralType::BOOL){
+        bool a = left.i != 0, b = right.i != 0;
+        if(op == "==") return intValue(LiteralType::BOOL, a == b);
+        if(op == "!=" || op == "^") return intValue(LiteralType::BOOL, a != b);
+        if(op == "&") return intValue(LiteralType::BOOL, a && b);
+        if(op == "|") return intValue(LiteralType::BOOL, a || b);
+        fail("operator " + op + " is not supported for bool");
+    }
+    bool numeric = (isIntType(left.type) || isFloatType(left.type)) && (isIntType(right.type) || isFloatType(right.type));
+    if(!numeric) fail("operator " + op + " is not supported for " + literalTypeName(left.type) + " and " + literalTypeName(right.type));
+
+    if(leftRaw) adaptLiteral(left, right.type);
+    if(rightRaw) adaptLiteral(right, left.type);
+    LiteralType common = promoteTypes(left.type, right.type);
+    left = castValue(left, common);
+    right = castValue(right, common);
+
+    if(isIntType(common)){
+        int64_t a = left.i, b = right.i;
+        uint64_t ua = static_cast<uint64_t>(a), ub = static_cast<uint64_t>(b);
+        bool isUnsigned = isUnsignedType(common);
+        if(op == "+") return intValue(common, static_cast<int64_t>(ua + ub));
+        if(op == "-") return intValue(common, static_cast<int64_t>(ua - ub));
+        if(op == "*") return intValue(common, static_cast<int64_t>(ua * ub));
+        if(op == "/" || op == "%"){
+            if(b == 0) fail("division by zero");
+            if(isUnsigned) return intValue(common, static_cast<int64_t>(op == "/" ? ua / ub : ua % ub));
+            if(b == -1 && a == normalizeInt(INT64_MIN, common)) fail("integer overflow in " + op);
+            return intValue(common, op == "/" ? a / b : a % b);
+        }
+        if(op == "&") return intValue(common, a & b);
+        if(op == "|") return intValue(common, a | b);
+        if(op == "^") return intValue(common, a ^ b);
+        if(op == "<<" || op == ">>"){
+            int shift = static_cast<int>(ub & (widthOf(common) - 1));
+            if(op == "<<") return intValue(common, static_cast<int64_t>(ua << shift));
+            return intValue(common, isUnsigned ? static_cast<int64_t>(ua >> shift) : a >> shift);
+        }
+        auto compare = [&](auto x, auto y){
+            if(op == "==") return x == y;
+            if(op == "!=") return x != y;
+            if(op == "<") return x < y;
+            if(op == "<=") return x <= y;
+            if(op == ">") return x > y;
+            if(op == ">=") return x >= y;
+            fail("unknown operator " + op);
+        };
+        return intValue(LiteralType::BOOL, isUnsigned ? compare(ua, ub) : compare(a, b));
+    }
+
+    // f32 dihitung di float supaya pembulatannya sama dengan instruksi float
+    auto floatOp = [&](auto a, auto b) -> ComptimeValue {
+        if(op == "+") return floatValue(common, a + b);
+        if(op == "-") return floatValue(common, a - b);
+        if(op == "*") return floatValue(common, a * b);
+        if(op == "/") return floatValue(common, a / b);
+        if(op == "%") return floatValue(common, std::fmod(a, b));
+        if(op == "==") return intValue(LiteralType::BOOL, a == b);
+        if(op == "!=") return intValue(LiteralType::BOOL, a < b || a > b); // fcmp one
+        if(op == "<") return intValue(LiteralType::BOOL, a < b);
+        if(op == "<=") return intValue(LiteralType::BOOL, a <= b);
+        if(op == ">") return intValue(LiteralType::BOOL, a > b);
+        if(op == ">=") return intValue(LiteralType::BOOL, a >= b);
+        fail("operator " + op + " needs integer or bool operands");
+    };
+    if(common == LiteralType::FLOAT) return floatOp(static_cast<float>(left.f), static_cast<float>(right.f));
+    return floatOp(left.f, right.f);
+}
+
+ComptimeValue ComptimeEvaluator::evalUnary(const std::string& op, const ComptimeValue& operand){
+    if(operand.isArray || !operand.structName.empty()) fail("operator " + op + " needs a scalar operand at compile time");
+    if(op == "-" && isIntType(operand.type)) return intValue(operand.type, static_cast<int64_t>(0 - static_cast<uint64_t>(operand.i)));
+    if(op == "-" && isFloatType(operand.type)) return floatValue(operand.type, -operand.f);
+    if(op == "!" && operand.type == LiteralType::BOOL) return intValue(LiteralType::BOOL, !operand.i);
+    if(op == "~" && isIntType(operand.type)) return intValue(operand.type, ~operand.i);
+    fail("operator " + op + " is not supported for " + literalTypeName(operand.type));
+}
+
+
+// ---------------- hasil ke AST ----------------
+
+// hasil comptime jadi literal / array literal / struct literal, tipenya sudah pasti (folded)
+std::shared_ptr<Stmt> ComptimeEvaluator::toStmt(const ComptimeValue& value){
+    if(value.isArray){
+        if(!value.structName.empty()) fail("arrays of structs cannot be emitted as constants");
+        const auto& dims = value.data->dims;
+        if(value.data->items.empty()){
+            std::vector<std::shared_ptr<Stmt>> sizes;
+            for(size_t d : dims) sizes.push_back(std::make_shared<LiteralStmt>(static_cast<int64_t>(d)));
+            return std::make_shared<DynArrayExpr>(value.type, sizes);
+        }
+        std::function<std::shared_ptr<Stmt>(size_t, size_t&)> build = [&](size_t depth, size_t& next) -> std::shared_ptr<Stmt> {
+            std::vector<std::shared_ptr<Stmt>> elements;
+            for(size_t k = 0; k < dims[depth]; k++){
+                if(depth + 1 < dims.size()) elements.push_back(build(depth + 1, next));
+                else elements.push_back(toStmt(value.data->items[next++]));
+            }
+            return std::make_shared<ArrayLiteralStmt>(elements);
+        };
+        size_t next = 0;
+        return build(0, next);
+    }
+    if(!value.structName.empty()){
+        std::vector<std::pair<std::string, std::shared_ptr<Stmt>>> fields;
+        const auto& decl = structs.at(value.structName);
+        for(size_t k = 0; k < decl->fields.size(); k++)
+            fields.push_back({decl->fields[k]->name, toStmt(value.data->items[k])});
+        return std::make_shared<StructExpr>(value.structName, fields);
+    }
+
+    std::shared_ptr<LiteralStmt> lit;
+    switch(value.type){
+        case LiteralType::FLOAT: lit = std::make_shared<LiteralStmt>(static_cast<float>(value.f)); break;
+        case LiteralType::DOUBLE: lit = std::make_shared<LiteralStmt>(value.f); break;
+        case LiteralType::BOOL: lit = std::make_shared<LiteralStmt>(value.i != 0); break;
+        case LiteralType::STRING: lit = std::make_shared<LiteralStmt>(value.s); break;
+        case LiteralType::INT_64: case LiteralType::UINT_64: case LiteralType::UINT_32:
+            // tipe asli (u32, u64) dipasang oleh pemakai literal (tipe variabel / elemen)
+            if(value.type == LiteralType::INT_64 || value.i < INT32_MIN || value.i > INT32_MAX){
+                lit = std::make_shared<LiteralStmt>(value.i);
+                break;
+            }
+            lit = std::make_shared<LiteralStmt>(static_cast<int32_t>(value.i));
+            break;
+        default:
+            if(!isIntType(value.type)) fail("value cannot be emitted as a constant");
+            lit = std::make_shared<LiteralStmt>(static_cast<int32_t>(value.i));
+            break;
+    }
+    lit->folded = true;
+    return lit;
+}
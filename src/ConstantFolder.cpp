@@ -0,0 +1,398 @@
+#include "../include/ConstantFolder.hpp"
+#include <cmath>
+#include <climits>
+
+static bool isIntLiteral(LiteralType t){ return t == LiteralType::INT_32 || t == LiteralType::INT_64; }
+static bool isFloatLiteral(LiteralType t){ return t == LiteralType::FLOAT || t == LiteralType::DOUBLE; }
+
+static int64_t intValue(const LiteralStmt& lit){
+    if(lit.dataType == LiteralType::INT_32) return std::get<int32_t>(lit.value);
+    return std::get<int64_t>(lit.value);
+}
+
+// literal hasil folding: i32 dipotong ke 32 bit (wrap seperti add / mul di llvm), f32 dibulatkan ke float
+static std::shared_ptr<LiteralStmt> makeInt(LiteralType ty, int64_t v){
+    auto lit = ty == LiteralType::INT_32 ? std::make_shared<LiteralStmt>(static_cast<int32_t>(v))
+                                         : std::make_shared<LiteralStmt>(v);
+    lit->folded = true;
+    return lit;
+}
+
+static std::shared_ptr<LiteralStmt> makeFloat(LiteralType ty, double v){
+    auto lit = ty == LiteralType::FLOAT ? std::make_shared<LiteralStmt>(static_cast<float>(v))
+                                        : std::make_shared<LiteralStmt>(v);
+    lit->folded = true;
+    return lit;
+}
+
+static std::shared_ptr<LiteralStmt> makeBool(bool v){
+    auto lit = std::make_shared<LiteralStmt>(v);
+    lit->folded = true;
+    return lit;
+}
+
+// ubah literal ke tipe lain seperti castToType, nullptr kalau tidak bisa tanpa mengubah nilai
+// (int yang tidak muat, float ke int, bool / str ke tipe lain)
+static std::shared_ptr<LiteralStmt> convertLiteral(const std::shared_ptr<LiteralStmt>& lit, LiteralType ty){
+    LiteralType from = lit->dataType;
+    if(from == ty) return lit;
+    if(isIntLiteral(from) && isIntLiteral(ty)){
+        int64_t v = intValue(*lit);
+        if(ty == LiteralType::INT_32 && (v < INT32_MIN || v > INT32_MAX)) return nullptr;
+        return makeInt(ty, v);
+    }
+    if(isIntLiteral(from) && isFloatLiteral(ty)){
+        int64_t v = intValue(*lit);
+        return ty == LiteralType::FLOAT ? makeFloat(ty, static_cast<float>(v)) : makeFloat(ty, static_cast<double>(v));
+    }
+    if(isFloatLiteral(from) && isFloatLiteral(ty)) return makeFloat(ty, std::get<double>(lit->value));
+    return nullptr;
+}
+
+// sama dengan promoteBinaryType: float menang atas int, lalu yang lebih lebar
+static LiteralType promoteLiteralType(LiteralType a, LiteralType b){
+    if(isFloatLiteral(a) || isFloatLiteral(b)){
+        if(a == LiteralType::DOUBLE || b == LiteralType::DOUBLE) return LiteralType::DOUBLE;
+        return LiteralType::FLOAT;
+    }
+    return (a == LiteralType::INT_64 || b == LiteralType::INT_64) ? LiteralType::INT_64 : LiteralType::INT_32;
+}
+
+
+void ConstantFolder::run(const std::shared_ptr<ProgramStmt>& program){
+    assigned.clear();
+    collectAssigned(program);
+    scopes.assign(1, {});
+    foldBlock(program->statements);
+    scopes.clear();
+}
+
+void ConstantFolder::collectAssigned(const std::shared_ptr<Stmt>& stmt){
+    if(stmt->type == StmtType::Assignment) assigned.insert(std::static_pointer_cast<AssignmentStmt>(stmt)->name);
+    forEachChild(stmt, [this](const std::shared_ptr<Stmt>& child){ collectAssigned(child); });
+}
+
+const ConstantFolder::Binding* ConstantFolder::lookup(const std::string& name) const {
+    for(auto it = scopes.rbegin(); it != scopes.rend(); ++it){
+        auto found = it->find(name);
+        if(found != it->end()) return &found->second;
+    }
+    return nullptr;
+}
+
+// variabel tanpa tipe / bertipe i32, i64, f32, f64, bool, str yang nilai awalnya literal dan tidak pernah
+// di-assign dibaca sebagai literal. deklarasinya tetap ada (misal s[i] untuk str masih butuh variabelnya)
+void ConstantFolder::declare(const std::shared_ptr<VarDeclStmt>& decl){
+    Binding binding;
+    binding.isConst = decl->isConst;
+    auto lit = std::dynamic_pointer_cast<LiteralStmt>(decl->initializer);
+    if(decl->isConst && (!lit || decl->isArray || !decl->structName.empty()))
+        throw std::runtime_error("const " + decl->name + " must be initialized with a constant expression");
+
+    if(lit && !decl->isArray && decl->structName.empty() && (decl->isConst || !assigned.count(decl->name))){
+        std::shared_ptr<LiteralStmt> value = decl->hasExplicit ? convertLiteral(lit, decl->varType) : lit;
+        if(value){
+            binding.value = std::make_shared<LiteralStmt>(*value);
+            binding.value->folded = true;
+        }
+    }
+    scopes.back()[decl->name] = binding;
+}
+
+
+void ConstantFolder::foldBlock(std::vector<std::shared_ptr<Stmt>>& block){
+    std::vector<std::shared_ptr<Stmt>> result;
+    for(const auto& stmt : block){
+        auto folded = foldStatement(stmt);
+        if(folded) result.push_back(folded);
+    }
+    block.swap(result);
+}
+
+void ConstantFolder::foldScoped(std::vector<std::shared_ptr<Stmt>>& block){
+    scopes.emplace_back();
+    foldBlock(block);
+    scopes.pop_back();
+}
+
+// nullptr = statement dibuang
+std::shared_ptr<Stmt> ConstantFolder::foldStatement(const std::shared_ptr<Stmt>& stmt){
+    switch(stmt->type){
+        case StmtType::VarDecl: {
+            auto decl = std::static_pointer_cast<VarDeclStmt>(stmt);
+            if(decl->initializer && decl->initializer->type == StmtType::Comptime){
+                LiteralType resultType = LiteralType::UNKNOWN;
+                decl->initializer = foldComptime(std::static_pointer_cast<ComptimeStmt>(decl->initializer), &resultType);
+                // literal hanya i32 / i64 / f32 / f64 / bool / str: tipe lain (u32, i8, ...) ditulis sebagai tipe variabel
+                bool literalType = resultType == LiteralType::INT_32 || resultType == LiteralType::INT_64 ||
+                                   resultType == LiteralType::FLOAT || resultType == LiteralType::DOUBLE ||
+                                   resultType == LiteralType::BOOL || resultType == LiteralType::STRING;
+                StmtType initType = decl->initializer->type;
+                if(!decl->hasExplicit && !literalType && resultType != LiteralType::UNKNOWN &&
+                   (initType == StmtType::Literal || initType == StmtType::ArrayLiteral)){
+                    decl->varType = resultType;
+                    decl->hasExplicit = true;
+                }
+            }
+            else decl->initializer = fold(decl->initializer);
+            declare(decl);
+            return stmt;
+        }
+        case StmtType::Assignment: {
+            auto assign = std::static_pointer_cast<AssignmentStmt>(stmt);
+            const Binding* binding = lookup(assign->name);
+            if(binding && binding->isConst) throw std::runtime_error("Cannot assign to const " + assign->name);
+            assign->value = fold(assign->value);
+            for(auto& idx : assign->indices) idx = fold(idx);
+            return stmt;
+        }
+        case StmtType::Print: {
+            auto print = std::static_pointer_cast<PrintStmt>(stmt);
+            print->expression = fold(print->expression);
+            return stmt;
+        }
+        case StmtType::If: return foldIf(std::static_pointer_cast<IfStmt>(stmt));
+        case StmtType::For: {
+            auto forStmt = std::static_pointer_cast<ForStmt>(stmt);
+            forStmt->start = fold(forStmt->start);
+            forStmt->end = fold(forStmt->end);
+            forStmt->step = fold(forStmt->step);
+            scopes.emplace_back();
+            scopes.back()[forStmt->var_name] = Binding{};
+            foldBlock(forStmt->block);
+            scopes.pop_back();
+            return stmt;
+        }
+        case StmtType::FunctionDecl: {
+            auto decl = std::static_pointer_cast<FunctionDeclStmt>(stmt);
+            scopes.emplace_back();
+            for(const auto& param : decl->params)
+                scopes.back()[std::static_pointer_cast<VarDeclStmt>(param)->name] = Binding{};
+            foldBlock(decl->body);
+            scopes.pop_back();
+            functions[decl->name] = decl;
+            return stmt;
+        }
+        case StmtType::Return: {
+            auto ret = std::static_pointer_cast<ReturnStmt>(stmt);
+            ret->value = fold(ret->value);
+            return stmt;
+        }
+        case StmtType::StructDecl: {
+            auto structStmt = std::static_pointer_cast<StructStmt>(stmt);
+            structs[structStmt->name] = structStmt;
+            return stmt;
+        }
+        case StmtType::Break: case StmtType::Continue:
+            return stmt;
+        default:
+            return fold(stmt); // pemanggilan function sebagai statement
+    }
+}
+
+// cabang dengan kondisi false dibuang, kondisi true menjadi cabang terakhir (else)
+std::shared_ptr<Stmt> ConstantFolder::foldIf(const std::shared_ptr<IfStmt>& ifStmt){
+    std::vector<std::shared_ptr<ElifStmt>> branches;
+    branches.push_back(std::make_shared<ElifStmt>(ifStmt->condition, ifStmt->then_block));
+    for(const auto& elif : ifStmt->elifs) branches.push_back(elif);
+
+    std::vector<std::shared_ptr<ElifStmt>> kept;
+    std::vector<std::shared_ptr<Stmt>> elseBlock = ifStmt->else_block;
+    bool alwaysTaken = false;
+    for(const auto& branch : branches){
+        branch->condition = fold(branch->condition);
+        foldScoped(branch->block);
+        auto lit = std::dynamic_pointer_cast<LiteralStmt>(branch->condition);
+        if(lit && lit->dataType == LiteralType::BOOL){
+            if(!std::get<bool>(lit->value)) continue;
+            elseBlock = branch->block;
+            alwaysTaken = true;
+            break;
+        }
+        kept.push_back(branch);
+    }
+    if(!alwaysTaken) foldScoped(elseBlock);
+    bool hasElse = alwaysTaken || !elseBlock.empty();
+
+    if(kept.empty()){
+        if(!hasElse) return nullptr;
+        // hanya else yang tersisa: tetap dibungkus if supaya scope-nya sama
+        return std::make_shared<IfStmt>(makeBool(true), elseBlock, std::vector<std::shared_ptr<ElifStmt>>{},
+                                        std::vector<std::shared_ptr<Stmt>>{});
+    }
+    ifStmt->condition = kept[0]->condition;
+    ifStmt->then_block = kept[0]->block;
+    ifStmt->elifs.assign(kept.begin() + 1, kept.end());
+    ifStmt->else_block = hasElse ? elseBlock : std::vector<std::shared_ptr<Stmt>>{};
+    return ifStmt;
+}
+
+std::shared_ptr<Stmt> ConstantFolder::fold(const std::shared_ptr<Stmt>& expr){
+    if(!expr) return expr;
+    switch(expr->type){
+        case StmtType::Identifier: {
+            const Binding* binding = lookup(std::static_pointer_cast<IdentifierStmt>(expr)->name);
+            if(binding && binding->value) return binding->value;
+            return expr;
+        }
+        case StmtType::BinaryOp: {
+            auto bin = std::static_pointer_cast<BinaryOpStmt>(expr);
+            bin->left = fold(bin->left);
+            bin->right = fold(bin->right);
+            // false && b = false, true || b = true (b tidak pernah dihitung), true && b / false || b = b
+            auto cond = std::dynamic_pointer_cast<LiteralStmt>(bin->left);
+            if(cond && cond->dataType == LiteralType::BOOL && (bin->op == "&&" || bin->op == "||")){
+                bool decided = std::get<bool>(cond->value) == (bin->op == "||");
+                return decided ? bin->left : bin->right;
+            }
+            auto left = std::dynamic_pointer_cast<LiteralStmt>(bin->left);
+            auto right = std::dynamic_pointer_cast<LiteralStmt>(bin->right);
+            if(left && right)
+                if(auto result = foldBinary(bin->op, left, right)) return result;
+            return expr;
+        }
+        case StmtType::UnaryOp: {
+            auto unary = std::static_pointer_cast<UnaryOpStmt>(expr);
+            // -literal masih dianggap literal biasa oleh adaptLiteral, hasilnya ikut tipe pasangannya
+            auto rawOperand = std::dynamic_pointer_cast<LiteralStmt>(unary->operand);
+            bool raw = unary->op == "-" && rawOperand && !rawOperand->folded;
+            unary->operand = fold(unary->operand);
+            auto operand = std::dynamic_pointer_cast<LiteralStmt>(unary->operand);
+            if(!operand) return expr;
+            auto result = foldUnary(unary->op, operand);
+            if(!result) return expr;
+            result->folded = !raw;
+            return result;
+        }
+        case StmtType::Typeof: {
+            auto typeOf = std::static_pointer_cast<TypeofStmt>(expr);
+            typeOf->expression = fold(typeOf->expression);
+            auto lit = std::dynamic_pointer_cast<LiteralStmt>(typeOf->expression);
+            if(!lit) return expr;
+            auto name = std::make_shared<LiteralStmt>(literalTypeName(lit->dataType));
+            name->folded = true;
+            return name;
+        }
+        case StmtType::FunctionCall:
+            for(auto& arg : std::static_pointer_cast<FunctionCallStmt>(expr)->args) arg = fold(arg);
+            return expr;
+        case StmtType::ArrayLiteral:
+            for(auto& elem : std::static_pointer_cast<ArrayLiteralStmt>(expr)->elements) elem = fold(elem);
+            return expr;
+        case StmtType::ArrayAccess:
+            for(auto& idx : std::static_pointer_cast<ArrayAccessStmt>(expr)->indices) idx = fold(idx);
+            return expr;
+        case StmtType::DynArrayNew:
+            for(auto& size : std::static_pointer_cast<DynArrayExpr>(expr)->sizes) size = fold(size);
+            return expr;
+        case StmtType::StructInit:
+            for(auto& field : std::static_pointer_cast<StructExpr>(expr)->fieldsValue) field.second = fold(field.second);
+            return expr;
+        case StmtType::MemberAccess: {
+            auto member = std::static_pointer_cast<MemberAccessExpr>(expr);
+            member->object = fold(member->object);
+            return expr;
+        }
+        case StmtType::Input: {
+            auto input = std::static_pointer_cast<InputStmt>(expr);
+            input->expr = fold(input->expr);
+            return expr;
+        }
+        case StmtType::Comptime: return foldComptime(std::static_pointer_cast<ComptimeStmt>(expr), nullptr);
+        default: return expr; // Literal
+    }
+}
+
+
+// comptime expr: dijalankan sekarang, diganti literal / array literal / struct literal hasilnya.
+// resultType diisi tipe skalar / tipe elemen array hasilnya
+std::shared_ptr<Stmt> ConstantFolder::foldComptime(const std::shared_ptr<ComptimeStmt>& comptime, LiteralType* resultType){
+    comptime->expression = fold(comptime->expression);
+    ComptimeEvaluator evaluator(functions, structs);
+    ComptimeValue value = evaluator.evaluate(comptime->expression);
+    if(resultType) *resultType = value.structName.empty() ? value.type : LiteralType::UNKNOWN;
+    return evaluator.toStmt(value);
+}
+
+
+// nullptr = tidak di-fold (tipe campuran yang ditolak codegen, bagi nol, dll), dibiarkan ke codegen
+std::shared_ptr<LiteralStmt> ConstantFolder::foldBinary(const std::string& op, std::shared_ptr<LiteralStmt> left, std::shared_ptr<LiteralStmt> right){
+    LiteralType lt = left->dataType, rt = right->dataType;
+
+    if(lt == LiteralType::STRING || rt == LiteralType::STRING){
+        if(lt != rt || (op != "==" && op != "!=")) return nullptr;
+        bool eq = std::get<std::string>(left->value) == std::get<std::string>(right->value);
+        return makeBool(op == "==" ? eq : !eq);
+    }
+    if(lt == LiteralType::BOOL || rt == LiteralType::BOOL){
+        if(lt != rt) return nullptr;
+        bool a = std::get<bool>(left->value), b = std::get<bool>(right->value);
+        if(op == "==") return makeBool(a == b);
+        if(op == "!=" || op == "^") return makeBool(a != b);
+        if(op == "&") return makeBool(a && b);
+        if(op == "|") return makeBool(a || b);
+        return nullptr;
+    }
+
+    // literal float mentah ikut tipe float pasangannya (adaptLiteral), int cukup dipromosikan
+    if(!left->folded && isFloatLiteral(lt) && isFloatLiteral(rt)) left = convertLiteral(left, rt);
+    if(!right->folded && isFloatLiteral(rt) && isFloatLiteral(left->dataType)) right = convertLiteral(right, left->dataType);
+    LiteralType common = promoteLiteralType(left->dataType, right->dataType);
+    left = convertLiteral(left, common);
+    right = convertLiteral(right, common);
+
+    if(isIntLiteral(common)){
+        int64_t a = intValue(*left), b = intValue(*right);
+        uint64_t ua = static_cast<uint64_t>(a), ub = static_cast<uint64_t>(b);
+        int64_t minValue = common == LiteralType::INT_32 ? INT32_MIN : INT64_MIN;
+        if(op == "+") return makeInt(common, static_cast<int64_t>(ua + ub));
+        if(op == "-") return makeInt(common, static_cast<int64_t>(ua - ub));
+        if(op == "*") return makeInt(common, static_cast<int64_t>(ua * ub));
+        if(op == "/" || op == "%"){
+            if(b == 0 || (a == minValue && b == -1)) return nullptr;
+            return makeInt(common, op == "/" ? a / b : a % b);
+        }
+        if(op == "&") return makeInt(common, a & b);
+        if(op == "|") return makeInt(common, a | b);
+        if(op == "^") return makeInt(common, a ^ b);
+        if(op == "<<" || op == ">>"){
+            int shift = static_cast<int>(ub & (common == LiteralType::INT_32 ? 31 : 63)); // sama dengan mask di codegen
+            return makeInt(common, op == "<<" ? static_cast<int64_t>(ua << shift) : a >> shift);
+        }
+        if(op == "==") return makeBool(a == b);
+        if(op == "!=") return makeBool(a != b);
+        if(op == "<") return makeBool(a < b);
+        if(op == "<=") return makeBool(a <= b);
+        if(op == ">") return makeBool(a > b);
+        if(op == ">=") return makeBool(a >= b);
+        return nullptr;
+    }
+
+    // f32 dihitung di float supaya pembulatannya sama dengan fadd / fmul float
+    auto floatOp = [&](auto a, auto b) -> std::shared_ptr<LiteralStmt> {
+        if(op == "+") return makeFloat(common, a + b);
+        if(op == "-") return makeFloat(common, a - b);
+        if(op == "*") return makeFloat(common, a * b);
+        if(op == "/") return makeFloat(common, a / b);
+        if(op == "%") return makeFloat(common, std::fmod(a, b));
+        if(op == "==") return makeBool(a == b);
+        if(op == "!=") return makeBool(a < b || a > b); // fcmp one: NaN tidak pernah "tidak sama"
+        if(op == "<") return makeBool(a < b);
+        if(op == "<=") return makeBool(a <= b);
+        if(op == ">") return makeBool(a > b);
+        if(op == ">=") return makeBool(a >= b);
+        return nullptr;
+    };
+    double a = std::get<double>(left->value), b = std::get<double>(right->value);
+    if(common == LiteralType::FLOAT) return floatOp(static_cast<float>(a), static_cast<float>(b));
+    return floatOp(a, b);
+}
+
+std::shared_ptr<LiteralStmt> ConstantFolder::foldUnary(const std::string& op, const std::shared_ptr<LiteralStmt>& operand){
+    LiteralType t = operand->dataType;
+    if(op == "-" && isIntLiteral(t)) return makeInt(t, static_cast<int64_t>(0 - static_cast<uint64_t>(intValue(*operand))));
+    if(op == "-" && isFloatLiteral(t)) return makeFloat(t, -std::get<double>(operand->value));
+    if(op == "!" && t == LiteralType::BOOL) return makeBool(!std::get<bool>(operand->value));
+    if(op == "~" && isIntLiteral(t)) return makeInt(t, ~intValue(*operand));
+    return nullptr;
+}
@@ -0,0 +1,120 @@
+#include "../include/DeadCode.hpp"
+#include <algorithm>
+
+
+// tandai ulang dari awal sampai tidak ada lagi yang dibuang: deklarasi yang dibuang bisa membuat
+// variabel / function yang disebut nilai awalnya ikut tidak terpakai
+void DeadCodeEliminator::run(const std::shared_ptr<ProgramStmt>& program){
+    bool changed = true;
+    while(changed){
+        functions.clear();
+        structs.clear();
+        called.clear();
+        used.clear();
+        collectDecls(program);
+        for(const auto& stmt : program->statements) mark(stmt);
+        changed = sweep(program->statements);
+    }
+}
+
+// semua function / struct di program, termasuk yang dideklarasikan di dalam blok
+void DeadCodeEliminator::collectDecls(const std::shared_ptr<Stmt>& stmt){
+    if(stmt->type == StmtType::FunctionDecl){
+        auto decl = std::static_pointer_cast<FunctionDeclStmt>(stmt);
+        functions[decl->name].push_back(decl);
+    }
+    if(stmt->type == StmtType::StructDecl){
+        auto decl = std::static_pointer_cast<StructStmt>(stmt);
+        structs[decl->name] = decl;
+    }
+    forEachChild(stmt, [this](const std::shared_ptr<Stmt>& child){ collectDecls(child); });
+}
+
+// catat nama yang disebut stmt. body function baru ditelusuri saat function-nya dipanggil,
+// deklarasi struct saat struct-nya dipakai
+void DeadCodeEliminator::mark(const std::shared_ptr<Stmt>& stmt){
+    switch(stmt->type){
+        case StmtType::FunctionDecl:
+        case StmtType::StructDecl:
+            return;
+        case StmtType::Identifier: used.insert(std::static_pointer_cast<IdentifierStmt>(stmt)->name); break;
+        case StmtType::ArrayAccess: used.insert(std::static_pointer_cast<ArrayAccessStmt>(stmt)->array_name); break;
+        case StmtType::Assignment: used.insert(std::static_pointer_cast<AssignmentStmt>(stmt)->name); break;
+        case StmtType::VarDecl: markStruct(std::static_pointer_cast<VarDeclStmt>(stmt)->structName); break;
+        case StmtType::StructInit: markStruct(std::static_pointer_cast<StructExpr>(stmt)->name); break;
+        case StmtType::DynArrayNew: markStruct(std::static_pointer_cast<DynArrayExpr>(stmt)->structName); break;
+        case StmtType::FunctionCall: {
+            auto found = functions.find(std::static_pointer_cast<FunctionCallStmt>(stmt)->name);
+            if(found != functions.end() && called.insert(found->first).second)
+                for(const auto& decl : found->second) markFunction(decl);
+            break;
+        }
+        default: break;
+    }
+    forEachChild(stmt, [this](const std::shared_ptr<Stmt>& child){ mark(child); });
+}
+
+void DeadCodeEliminator::markFunction(const std::shared_ptr<FunctionDeclStmt>& decl){
+    markStruct(decl->returnStruct);
+    for(const auto& param : decl->params) mark(param);
+    for(const auto& stmt : decl->body) mark(stmt);
+}
+
+// struct terpakai ikut memakai struct yang jadi tipe field-nya
+void DeadCodeEliminator::markStruct(const std::string& name){
+    if(name.empty() || !used.insert(name).second) return;
+    auto found = structs.find(name);
+    if(found == structs.end()) return;
+    for(const auto& field : found->second->fields) markStruct(field->structName);
+}
+
+// nilai awal yang boleh dibuang: tanpa call, input, akses index (bisa runtime error) atau alokasi
+bool DeadCodeEliminator::isPure(const std::shared_ptr<Stmt>& expr){
+    if(!expr) return true;
+    switch(expr->type){
+        case StmtType::Literal:
+        case StmtType::Identifier:
+            return true;
+        case StmtType::ArrayLiteral:
+        case StmtType::StructInit:
+        case StmtType::BinaryOp:
+        case StmtType::UnaryOp:
+        case StmtType::MemberAccess:
+        case StmtType::Typeof: {
+            bool pure = true;
+            forEachChild(expr, [&](const std::shared_ptr<Stmt>& child){ pure = pure && isPure(child); });
+            return pure;
+        }
+        default:
+            return false;
+    }
+}
+
+// buang function / struct / variabel yang tidak terpakai dari blok (dan blok di dalamnya)
+bool DeadCodeEliminator::sweep(std::vector<std::shared_ptr<Stmt>>& block){
+    size_t before = block.size();
+    block.erase(std::remove_if(block.begin(), block.end(), [this](const std::shared_ptr<Stmt>& stmt){
+        if(stmt->type == StmtType::FunctionDecl) return !called.count(std::static_pointer_cast<FunctionDeclStmt>(stmt)->name);
+        if(stmt->type == StmtType::StructDecl) return !used.count(std::static_pointer_cast<StructStmt>(stmt)->name);
+        if(stmt->type == StmtType::VarDecl){
+            auto decl = std::static_pointer_cast<VarDeclStmt>(stmt);
+            return !used.count(decl->name) && isPure(decl->initializer);
+        }
+        return false;
+    }), block.end());
+
+    bool changed = block.size() != before;
+    for(const auto& stmt : block){
+        if(stmt->type == StmtType::FunctionDecl)
+            changed |= sweep(std::static_pointer_cast<FunctionDeclStmt>(stmt)->body);
+        else if(stmt->type == StmtType::For)
+            changed |= sweep(std::static_pointer_cast<ForStmt>(stmt)->block);
+        else if(stmt->type == StmtType::If){
+            auto ifStmt = std::static_pointer_cast<IfStmt>(stmt);
+            changed |= sweep(ifStmt->then_block);
+            for(const auto& elif : ifStmt->elifs) changed |= sweep(elif->block);
+            changed |= sweep(ifStmt->else_block);
+        }
+    }
+    return changed;
+}
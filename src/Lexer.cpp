@@ -31,7 +31,7 @@ void Lexer::skip_comment(){
 }
 
 
-bool Lexer::isAlphaNumeric(char ch){ return (std::isalpha(ch) || std::isdigit(ch)); }
+bool Lexer::isAlphaNumeric(char ch){ return (std::isalpha(ch) || std::isdigit(ch) || ch == '_'); }
 
 
 Token Lexer::readNumber(){
@@ -49,8 +49,14 @@ Token Lexer::readNumber(){
             result += this->currentChar;
             this->next_char();
         }
-        return Token(TokenType::DOUBLE_LITERAL, result);
     }
+    // akhiran f (1.5f, 2f) = literal f32
+    char after = this->input[this->position + 1];
+    if(this->currentChar == 'f' && !std::isalnum(static_cast<unsigned char>(after)) && after != '_'){
+        this->next_char();
+        return Token(TokenType::FLOAT_LITERAL, result);
+    }
+    if(result.find('.') != std::string::npos) return Token(TokenType::DOUBLE_LITERAL, result);
     return Token(TokenType::INT_LITERAL, result);
 }
 
@@ -109,6 +115,8 @@ Token Lexer::readIdentifier(){
 
     std::unordered_map<std::string, TokenType> keywords = {
         {"var", TokenType::VAR},
+        {"const", TokenType::CONST},
+        {"comptime", TokenType::COMPTIME},
         {"print", TokenType::PRINT},
         {"if", TokenType::IF},
         {"elif", TokenType::ELIF},
@@ -121,13 +129,20 @@ Token Lexer::readIdentifier(){
         {"input", TokenType::INPUT},
         {"break", TokenType::BREAK},
         {"continue", TokenType::CONTINUE},
+        {"i8", TokenType::TYPE},
+        {"i16", TokenType::TYPE},
         {"i32", TokenType::TYPE},
         {"i64", TokenType::TYPE},
+        {"u8", TokenType::TYPE},
+        {"u16", TokenType::TYPE},
+        {"u32", TokenType::TYPE},
+        {"u64", TokenType::TYPE},
         {"f32", TokenType::TYPE},
         {"f64", TokenType::TYPE},
         {"bool", TokenType::TYPE},
         {"str", TokenType::TYPE},
         {"struct", TokenType::STRUCT},
+        {"not", TokenType::OPERATOR}, // sama dengan !
         // {"while", TokenType::WHILE},
     };
 
@@ -169,7 +184,7 @@ Token Lexer::get_next_token(){
         if(this->currentChar == '-' && std::isdigit(this->input[this->position + 1])){
             this->next_char();
             Token numberToken = this->readNumber();
-            numberToken.value = std::to_string(std::atoi(numberToken.value.c_str()) * -1);
+            numberToken.value = "-" + numberToken.value; // tipe (int / double / f32) tetap
             return numberToken;
         }
 
@@ -183,10 +198,16 @@ Token Lexer::get_next_token(){
         }
 
         // handle identifier
-        if(std::isalpha(this->currentChar)){
+        if(std::isalpha(this->currentChar) || this->currentChar == '_'){
             return this->readIdentifier();
         }
 
+        // anotasi sebelum deklarasi: @soa
+        if(this->currentChar == '@' && std::isalpha(this->input[this->position + 1])){
+            this->next_char();
+            return Token(TokenType::ANNOTATION, this->readIdentifier().value);
+        }
+
         // handle operators
         if(this->currentChar == '+' || this->currentChar == '-' ||
             this->currentChar == '*' || this->currentChar == '/' ||
@@ -205,6 +226,24 @@ Token Lexer::get_next_token(){
             return Token(TokenType::OPERATOR, std::string(1, first));
         }
 
+        // bitwise dan logika: & | ^ ~, &= |= ^=, && || (short-circuit)
+        if(this->currentChar == '&' || this->currentChar == '|' ||
+            this->currentChar == '^' || this->currentChar == '~') {
+
+            char first = this->currentChar;
+            this->next_char();
+
+            if((first == '&' || first == '|') && this->currentChar == first) {
+                this->next_char();
+                return Token(TokenType::OPERATOR, std::string(2, first)); // && atau ||
+            }
+            if(first != '~' && this->currentChar == '=') {
+                this->next_char();
+                return Token(TokenType::OPERATOR, std::string(1, first) + "="); // &=, |=, ^=
+            }
+            return Token(TokenType::OPERATOR, std::string(1, first));
+        }
+
         // Comparison dan assignment
         if (this->currentChar == '>' || this->currentChar == '<' ||
             this->currentChar == '=' || this->currentChar == '!') {
@@ -212,6 +251,17 @@ Token Lexer::get_next_token(){
             char op = this->currentChar;
             this->next_char();
 
+            // shift: << >> <<= >>=
+            if ((op == '<' || op == '>') && this->currentChar == op) {
+                std::string shift(2, op);
+                this->next_char();
+                if (this->currentChar == '=') {
+                    shift += "=";
+                    this->next_char();
+                }
+                return Token(TokenType::OPERATOR, shift);
+            }
+
             if (this->currentChar == '=') {
                 std::string combined = std::string(1, op) + "=";
                 this->next_char();
@@ -41,6 +41,11 @@ std::shared_ptr<ProgramStmt> Parser::parse(){
 
 std::shared_ptr<Stmt> Parser::parseStatement(){
     if(this->match(TokenType::VAR).has_value()) return this->parseVarDeclStmt();
+    if(this->match(TokenType::CONST).has_value()){
+        auto decl = this->parseVarDeclStmt();
+        decl->isConst = true;
+        return decl;
+    }
     if(this->match(TokenType::PRINT).has_value()) return this->parsePrintStmt();
     if(this->match(TokenType::IF).has_value()) return this->parseIfStmt();
     if(this->match(TokenType::FOR).has_value()) return this->parseForStmt();
@@ -57,13 +62,39 @@ std::shared_ptr<Stmt> Parser::parseStatement(){
     }
     if(this->match(TokenType::STRUCT).has_value()) return this->parseStructDecl();
 
+    // @soa struct Particle { ... }; / @inline fun f(...) { ... }
+    if(this->current.type == TokenType::ANNOTATION){
+        std::vector<std::string> annotations;
+        while(this->current.type == TokenType::ANNOTATION){
+            annotations.push_back(this->current.value);
+            this->next_token();
+        }
+        if(this->match(TokenType::STRUCT).has_value()){
+            auto structStmt = std::static_pointer_cast<StructStmt>(this->parseStructDecl());
+            structStmt->annotations = annotations;
+            return structStmt;
+        }
+        if(this->match(TokenType::FUN).has_value()){
+            auto funcDecl = this->parseFunctionDeclStmt();
+            funcDecl->annotations = annotations;
+            return funcDecl;
+        }
+        throw std::runtime_error("Annotation @" + annotations[0] + " must be followed by a struct or function declaration");
+    }
+
     throw std::runtime_error("Unexpected token: " + tokenTypeToString(this->current.type));
 }
 
 
 LiteralType mapStringToLiteralType(const std::string& s){
+    if(s == "i8") return LiteralType::INT_8;
+    if(s == "i16") return LiteralType::INT_16;
     if(s == "i32") return LiteralType::INT_32;
-    if(s == "i64") return LiteralType::INT_64; // nanti diperluas
+    if(s == "i64") return LiteralType::INT_64;
+    if(s == "u8") return LiteralType::UINT_8;
+    if(s == "u16") return LiteralType::UINT_16;
+    if(s == "u32") return LiteralType::UINT_32;
+    if(s == "u64") return LiteralType::UINT_64;
     if(s == "f32") return LiteralType::FLOAT;
     if(s == "f64") return LiteralType::DOUBLE;
     if(s == "bool") return LiteralType::BOOL;
@@ -114,9 +145,15 @@ std::shared_ptr<VarDeclStmt> Parser::parseVarDeclStmt(){
     // opsional pengecekan untuk tipe eksplisit
     LiteralType explicitType = LiteralType::UNKNOWN;
     bool hasExplicit = false;
+    std::string structName;
     if(this->match(TokenType::COLON)){
-        Token typeToken = this->expect(TokenType::TYPE); // TYPE = i32, f64, bool, string, dll
-        explicitType = mapStringToLiteralType(typeToken.value);
+        if(this->current.type == TokenType::IDENTIFIER){ // var p: Point = ...
+            structName = this->expect(TokenType::IDENTIFIER).value;
+            explicitType = LiteralType::STRUCT;
+        } else {
+            Token typeToken = this->expect(TokenType::TYPE); // TYPE = i32, f64, bool, string, dll
+            explicitType = mapStringToLiteralType(typeToken.value);
+        }
         hasExplicit = true;
     }
 
@@ -127,7 +164,9 @@ std::shared_ptr<VarDeclStmt> Parser::parseVarDeclStmt(){
     }
 
     this->expect(TokenType::SEMICOLON, ";");
-    return std::make_shared<VarDeclStmt>(name, value, explicitType, hasExplicit);
+    auto decl = std::make_shared<VarDeclStmt>(name, value, explicitType, hasExplicit);
+    decl->structName = structName;
+    return decl;
 }
 
 
@@ -173,20 +212,21 @@ std::shared_ptr<ForStmt> Parser::parseForStmt(){
     auto startLit = std::dynamic_pointer_cast<LiteralStmt>(start);
     auto endLit = std::dynamic_pointer_cast<LiteralStmt>(end);
 
-    if (!startLit || !endLit)
-        throw std::runtime_error("For loop start and end must be integer literals");
-
-    // cek jika value adalah int32_t
-    if (!std::holds_alternative<int32_t>(startLit->value) || 
-        !std::holds_alternative<int32_t>(endLit->value))
-    {
-        throw std::runtime_error("For loop only supports integer literals");
-    }
+    // batas berupa literal: arah step bisa ditentukan sekarang
+    // batas berupa ekspresi (misal len(arr)): selalu naik
+    if (startLit && endLit) {
+        // cek jika value adalah int32_t
+        if (!std::holds_alternative<int32_t>(startLit->value) || 
+            !std::holds_alternative<int32_t>(endLit->value))
+        {
+            throw std::runtime_error("For loop only supports integer literals");
+        }
 
-    int32_t startVal = std::get<int32_t>(startLit->value);
-    int32_t endVal = std::get<int32_t>(endLit->value);
+        int32_t startVal = std::get<int32_t>(startLit->value);
+        int32_t endVal = std::get<int32_t>(endLit->value);
 
-    if (startVal > endVal) step = -1;
+        if (startVal > endVal) step = -1;
+    }
 
     std::shared_ptr<Stmt> stepStmt = std::make_shared<LiteralStmt>(int32_t(step));
 
@@ -219,14 +259,36 @@ std::shared_ptr<FunctionDeclStmt> Parser::parseFunctionDeclStmt(){
         // cek tipe eksplisit setelah ':'
         LiteralType paramType = LiteralType::UNKNOWN;
         bool hasExplicit = false;
+        bool isArray = false;
+        std::string paramStruct;
         if(this->match(TokenType::COLON)) {
-            Token typeToken = this->expect(TokenType::TYPE); // misal "i32", "f64"
-            paramType = mapStringToLiteralType(typeToken.value);
+            if(this->current.type == TokenType::IDENTIFIER && this->current.value == "array") {
+                // array<tipe>: array statis / dinamis dikirim by reference
+                this->expect(TokenType::IDENTIFIER, "array");
+                this->expect(TokenType::COMPARISON, "<");
+                if(this->current.type == TokenType::IDENTIFIER){ // array<Point>
+                    paramStruct = this->expect(TokenType::IDENTIFIER).value;
+                    paramType = LiteralType::STRUCT;
+                } else {
+                    paramType = mapStringToLiteralType(this->expect(TokenType::TYPE).value);
+                }
+                this->expect(TokenType::COMPARISON, ">");
+                isArray = true;
+            } else if(this->current.type == TokenType::IDENTIFIER) { // struct, dikirim by value
+                paramStruct = this->expect(TokenType::IDENTIFIER).value;
+                paramType = LiteralType::STRUCT;
+            } else {
+                Token typeToken = this->expect(TokenType::TYPE); // misal "i32", "f64"
+                paramType = mapStringToLiteralType(typeToken.value);
+            }
             hasExplicit = true;
         }
 
         // buat VarDeclStmt untuk parameter
-        params.push_back(std::make_shared<VarDeclStmt>(paramName, nullptr, paramType, hasExplicit));
+        auto param = std::make_shared<VarDeclStmt>(paramName, nullptr, paramType, hasExplicit);
+        param->isArray = isArray;
+        param->structName = paramStruct;
+        params.push_back(param);
 
         if(!this->match(TokenType::COMMA))
             break; // tidak ada koma lagi
@@ -234,9 +296,35 @@ std::shared_ptr<FunctionDeclStmt> Parser::parseFunctionDeclStmt(){
 
     
     this->expect(TokenType::RPAREN);
+
+    // tipe return opsional: fun f(x): f64 { ... }
+    bool hasReturnType = false, returnsArray = false;
+    LiteralType returnType = LiteralType::UNKNOWN;
+    std::string returnStruct;
+    if(this->match(TokenType::COLON)) {
+        hasReturnType = true;
+        if(this->current.type == TokenType::IDENTIFIER && this->current.value == "array") {
+            this->expect(TokenType::IDENTIFIER, "array");
+            this->expect(TokenType::COMPARISON, "<");
+            returnType = mapStringToLiteralType(this->expect(TokenType::TYPE).value);
+            this->expect(TokenType::COMPARISON, ">");
+            returnsArray = true;
+        } else if(this->current.type == TokenType::IDENTIFIER) { // nama struct
+            returnStruct = this->expect(TokenType::IDENTIFIER).value;
+            returnType = LiteralType::STRUCT;
+        } else {
+            returnType = mapStringToLiteralType(this->expect(TokenType::TYPE).value);
+        }
+    }
+
     std::vector<std::shared_ptr<Stmt>> body = this->parseBlock();
     
-    return std::make_shared<FunctionDeclStmt>(name, params, body);
+    auto func = std::make_shared<FunctionDeclStmt>(name, params, body);
+    func->hasReturnType = hasReturnType;
+    func->returnType = returnType;
+    func->returnStruct = returnStruct;
+    func->returnsArray = returnsArray;
+    return func;
 }
 
 
@@ -270,40 +358,55 @@ std::shared_ptr<Stmt> Parser::parseIdentifierStmt(){
     
     // std::cout << tokenTypeToString(this->current.type) << "\n";
 
-    // array access
-    std::shared_ptr<Stmt> index = nullptr;
-    if(this->match(TokenType::LBRACKET)){
-        index = this->parseExpression();
+    // array access, bisa multi dimensi: m[i][j]
+    std::vector<std::shared_ptr<Stmt>> indices;
+    while(this->match(TokenType::LBRACKET)){
+        indices.push_back(this->parseExpression());
         this->expect(TokenType::RBRACKET);
     }
 
+    // field struct: p.x = 1, p.pos.x += 2
+    std::vector<std::string> members;
+    while(this->match(TokenType::DOT)){
+        members.push_back(this->expect(TokenType::IDENTIFIER).value);
+    }
+
     // assign
     if(this->match(TokenType::ASSIGN)){
         std::shared_ptr<Stmt> expr = this->parseExpression();
         this->expect(TokenType::SEMICOLON);
 
         auto id = std::dynamic_pointer_cast<IdentifierStmt>(idStmt);
-        return std::make_shared<AssignmentStmt>(id.get()->name, expr, index);
+        auto assign = std::make_shared<AssignmentStmt>(id.get()->name, expr, indices);
+        assign->members = members;
+        return assign;
     }
 
     if(this->current.type == TokenType::OPERATOR) {
         std::string op = this->current.value; // ambil operator
         this->next_token(); // konsumsi operator
     
-        if(op == "+=" || op == "-=" || op == "*=" || op == "/=" || op == "%=") {
+        if(op == "+=" || op == "-=" || op == "*=" || op == "/=" || op == "%=" ||
+           op == "&=" || op == "|=" || op == "^=" || op == "<<=" || op == ">>=") {
             std::shared_ptr<Stmt> expr = this->parseExpression();
             this->expect(TokenType::SEMICOLON);
     
             auto id = std::dynamic_pointer_cast<IdentifierStmt>(idStmt);
+            // a[i] += x: sisi kiri operasi harus elemen array, bukan array-nya
+            std::shared_ptr<Stmt> lhs = idStmt;
+            if(!indices.empty()) lhs = std::make_shared<ArrayAccessStmt>(id->name, indices);
+            for(const auto& member : members) lhs = std::make_shared<MemberAccessExpr>(lhs, member);
     
             // Ubah jadi Assignment( id = BinaryOp(id, op, expr) )
             auto binary = std::make_shared<BinaryOpStmt>(
-                idStmt,                   // lhs
-                op.substr(0, 1),          // ambil operator dasar: "+", "-", "*", "/", "%"
+                lhs,                      // lhs
+                op.substr(0, op.size() - 1), // ambil operator dasar: "+", "-", ..., "<<", ">>"
                 expr                      // rhs
             );
     
-            return std::make_shared<AssignmentStmt>(id->name, binary, index);
+            auto assign = std::make_shared<AssignmentStmt>(id->name, binary, indices);
+            assign->members = members;
+            return assign;
         }
     }
     
@@ -362,14 +465,23 @@ std::shared_ptr<Stmt> Parser::parseStructDecl(){
             throw std::runtime_error(fieldName + " doesn't have a tipe");
         }
     
-        Token typeToken = this->expect(TokenType::TYPE); // misal "i32", "f64"
-        fieldType = mapStringToLiteralType(typeToken.value);
+        // field bisa bertipe struct lain yang sudah dideklarasikan (disimpan langsung, bukan pointer)
+        std::string fieldStruct;
+        if(this->current.type == TokenType::IDENTIFIER){
+            fieldStruct = this->expect(TokenType::IDENTIFIER).value;
+            fieldType = LiteralType::STRUCT;
+        } else {
+            Token typeToken = this->expect(TokenType::TYPE); // misal "i32", "f64"
+            fieldType = mapStringToLiteralType(typeToken.value);
+        }
 
         if(fieldType == LiteralType::UNKNOWN)
             throw std::runtime_error("Unknown type for field " + fieldName);
 
         // buat StructField untuk parameter
-        fields.push_back(std::make_shared<StructField>(fieldName, fieldType));
+        auto field = std::make_shared<StructField>(fieldName, fieldType);
+        field->structName = fieldStruct;
+        fields.push_back(field);
 
         if(!this->match(TokenType::COMMA))
             break; // tidak ada koma lagi
@@ -413,6 +525,33 @@ std::shared_ptr<Stmt> Parser::parseStructInit(){
 
 
 
+// array<tipe>(ukuran), tipe bisa nama struct: array<Point>(n)
+std::shared_ptr<Stmt> Parser::parseDynArray(){
+    this->expect(TokenType::IDENTIFIER, "array");
+    this->expect(TokenType::COMPARISON, "<");
+    LiteralType elemType = LiteralType::STRUCT;
+    std::string structName;
+    if(this->current.type == TokenType::IDENTIFIER) structName = this->expect(TokenType::IDENTIFIER).value;
+    else elemType = mapStringToLiteralType(this->expect(TokenType::TYPE).value);
+    this->expect(TokenType::COMPARISON, ">");
+
+    this->expect(TokenType::LPAREN);
+    std::vector<std::shared_ptr<Stmt>> sizes;
+    if(this->current.type != TokenType::RPAREN){
+        sizes.push_back(this->parseExpression());
+        while(this->match(TokenType::COMMA)){
+            sizes.push_back(this->parseExpression());
+        }
+    }
+    this->expect(TokenType::RPAREN);
+
+    auto dyn = std::make_shared<DynArrayExpr>(elemType, sizes);
+    dyn->structName = structName;
+    return dyn;
+}
+
+
+
 std::vector<std::shared_ptr<Stmt>> Parser::parseBlock(){
     this->expect(TokenType::LBRACE);
     std::vector<std::shared_ptr<Stmt>> statements;
@@ -441,7 +580,28 @@ std::shared_ptr<Stmt> Parser::parseExpressionUntil(TokenType endType){
 }
 
 std::shared_ptr<Stmt> Parser::parseExpression(){
-    return this->parseEquality();
+    return this->parseLogicalOr();
+}
+
+
+// || paling rendah, lalu &&: a || b && c == a || (b && c)
+std::shared_ptr<Stmt> Parser::parseLogicalOr(){
+    std::shared_ptr<Stmt> left = this->parseLogicalAnd();
+    while(this->match(TokenType::OPERATOR, "||")){
+        std::shared_ptr<Stmt> right = this->parseLogicalAnd();
+        left = std::make_shared<BinaryOpStmt>(left, "||", right);
+    }
+    return left;
+}
+
+
+std::shared_ptr<Stmt> Parser::parseLogicalAnd(){
+    std::shared_ptr<Stmt> left = this->parseEquality();
+    while(this->match(TokenType::OPERATOR, "&&")){
+        std::shared_ptr<Stmt> right = this->parseEquality();
+        left = std::make_shared<BinaryOpStmt>(left, "&&", right);
+    }
+    return left;
 }
 
 
@@ -457,9 +617,51 @@ std::shared_ptr<Stmt> Parser::parseEquality(){
 
 
 std::shared_ptr<Stmt> Parser::parseComparison(){
-    std::shared_ptr<Stmt> left = this->parseTerm();
+    std::shared_ptr<Stmt> left = this->parseBitwiseOr();
     while(this->match(TokenType::COMPARISON)){
         std::string op = this->tokens[this->position - 1].value;;
+        std::shared_ptr<Stmt> right = this->parseBitwiseOr();
+        left = std::make_shared<BinaryOpStmt>(left, op, right);
+    }
+    return left;
+}
+
+
+// bitwise di atas perbandingan (x & 1 == 0 berarti (x & 1) == 0): | lalu ^ lalu & lalu shift
+std::shared_ptr<Stmt> Parser::parseBitwiseOr(){
+    std::shared_ptr<Stmt> left = this->parseBitwiseXor();
+    while(this->match(TokenType::OPERATOR, "|")){
+        std::shared_ptr<Stmt> right = this->parseBitwiseXor();
+        left = std::make_shared<BinaryOpStmt>(left, "|", right);
+    }
+    return left;
+}
+
+
+std::shared_ptr<Stmt> Parser::parseBitwiseXor(){
+    std::shared_ptr<Stmt> left = this->parseBitwiseAnd();
+    while(this->match(TokenType::OPERATOR, "^")){
+        std::shared_ptr<Stmt> right = this->parseBitwiseAnd();
+        left = std::make_shared<BinaryOpStmt>(left, "^", right);
+    }
+    return left;
+}
+
+
+std::shared_ptr<Stmt> Parser::parseBitwiseAnd(){
+    std::shared_ptr<Stmt> left = this->parseShift();
+    while(this->match(TokenType::OPERATOR, "&")){
+        std::shared_ptr<Stmt> right = this->parseShift();
+        left = std::make_shared<BinaryOpStmt>(left, "&", right);
+    }
+    return left;
+}
+
+
+std::shared_ptr<Stmt> Parser::parseShift(){
+    std::shared_ptr<Stmt> left = this->parseTerm();
+    while(this->match(TokenType::OPERATOR, "<<") || this->match(TokenType::OPERATOR, ">>")){
+        std::string op = this->tokens[this->position - 1].value;
         std::shared_ptr<Stmt> right = this->parseTerm();
         left = std::make_shared<BinaryOpStmt>(left, op, right);
     }
@@ -490,11 +692,15 @@ std::shared_ptr<Stmt> Parser::parseFactor(){
 
 
 std::shared_ptr<Stmt> Parser::parseUnary(){
-    while(this->match(TokenType::OPERATOR, "-") || this->match(TokenType::OPERATOR, "!")){
+    while(this->match(TokenType::OPERATOR, "-") || this->match(TokenType::OPERATOR, "!") ||
+          this->match(TokenType::OPERATOR, "not") || this->match(TokenType::OPERATOR, "~")){
         std::string op = this->tokens[this->position - 1].value;
+        if(op == "not") op = "!";
         std::shared_ptr<Stmt> right = this->parseUnary();
         return std::make_shared<UnaryOpStmt>(op, right);
     }
+    // comptime f(x) / comptime (a * b): berlaku untuk satu operand, seperti unary
+    if(this->match(TokenType::COMPTIME).has_value()) return std::make_shared<ComptimeStmt>(this->parseUnary());
     return parsePrimary();
 }
 
@@ -502,6 +708,7 @@ std::shared_ptr<Stmt> Parser::parseUnary(){
 std::shared_ptr<Stmt> Parser::parsePrimary(){
     if(this->current.type == TokenType::INT_LITERAL ||
         this->current.type == TokenType::DOUBLE_LITERAL ||
+        this->current.type == TokenType::FLOAT_LITERAL ||
         this->current.type == TokenType::STRING_LITERAL ||
         this->current.type == TokenType::BOOLEAN_LITERAL)
     {
@@ -514,7 +721,11 @@ std::shared_ptr<Stmt> Parser::parsePrimary(){
             if(res.ec == std::errc::invalid_argument){
                 throw std::runtime_error("Invalid integer literal: " + raw);
             } else if(res.ec == std::errc::result_out_of_range){
-                throw std::runtime_error("Integer literal out of range: " + raw);
+                // di atas i64 tapi muat di u64: bit-nya disimpan apa adanya (dipakai var x: u64 = ...)
+                uint64_t u = 0;
+                auto ures = std::from_chars(raw.data(), raw.data() + raw.size(), u);
+                if(ures.ec != std::errc()) throw std::runtime_error("Integer literal out of range: " + raw);
+                v = static_cast<int64_t>(u);
             }
         
             // pilih constructor LiteralStmt yang sesuai
@@ -533,6 +744,12 @@ std::shared_ptr<Stmt> Parser::parsePrimary(){
             return std::make_shared<LiteralStmt>(d);
         }
 
+        if(this->current.type == TokenType::FLOAT_LITERAL) {
+            this->next_token();
+            float f = std::strtof(raw.c_str(), nullptr);
+            return std::make_shared<LiteralStmt>(f);
+        }
+
         if(this->current.type == TokenType::BOOLEAN_LITERAL){
             std::string raw = this->current.value; // "true" atau "false"
             this->next_token();
@@ -563,6 +780,13 @@ std::shared_ptr<Stmt> Parser::parsePrimary(){
             this->tokens[this->position + 1].type == TokenType::LBRACE){
             return this->parseStructInit();            
         }
+        if( this->current.value == "array" && // array dinamis: array<tipe>(n)
+            this->position + 3 < tokens.size() &&
+            this->tokens[this->position + 1].value == "<" &&
+            (this->tokens[this->position + 2].type == TokenType::TYPE || this->tokens[this->position + 2].type == TokenType::IDENTIFIER) &&
+            this->tokens[this->position + 3].value == ">"){
+            return this->parseDynArray();
+        }
         // variabel biasa
         std::shared_ptr<Stmt> ID = std::make_shared<IdentifierStmt>(this->current.value);
         this->next_token();
@@ -585,15 +809,23 @@ std::shared_ptr<Stmt> Parser::parsePrimary(){
             return this->parseFunctionCallStmt(ID);
         }
 
-        // cek array
+        // cek array, index berturut-turut m[i][j] jadi satu akses
         if(this->match(TokenType::LBRACKET)){
-            std::shared_ptr<Stmt> index = this->parseExpression();
-            this->expect(TokenType::RBRACKET);
+            std::vector<std::shared_ptr<Stmt>> indices;
+            do {
+                indices.push_back(this->parseExpression());
+                this->expect(TokenType::RBRACKET);
+            } while(this->match(TokenType::LBRACKET));
             auto idStmt = std::dynamic_pointer_cast<IdentifierStmt>(ID);
             if (!idStmt) {
                 throw std::runtime_error("Expected identifier in array access");
             }
-            return std::make_shared<ArrayAccessStmt>(idStmt->name, index);
+            std::shared_ptr<Stmt> access = std::make_shared<ArrayAccessStmt>(idStmt->name, indices);
+            // field elemen array struct: pts[i].x, pts[i].pos.y
+            while(this->match(TokenType::DOT)){
+                access = std::make_shared<MemberAccessExpr>(access, this->expect(TokenType::IDENTIFIER).value);
+            }
+            return access;
         }
         return ID;
     }
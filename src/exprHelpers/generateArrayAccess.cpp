@@ -6,13 +6,19 @@ llvm::Value* CodeGen::generateArrayAccess(const std::shared_ptr<ArrayAccessStmt>
         throw std::runtime_error("Variable is not an array");
     }
     
-    llvm::Value* idxVal = generateExpression(accessStmt->index);
-    llvm::Value* elemPtr = generateArrayElementPtr(var, idxVal);
-    
-    // load dari elemPtr karena ini expression
-    return builder.CreateLoad(
-        elemPtr->getType()->getPointerElementType(),
-        elemPtr,
-        "array_load"
-    );
-}
+    std::vector<llvm::Value*> indices;
+    for (const auto& idx : accessStmt->indices) indices.push_back(generateExpression(idx));
+    llvm::Value* linear = generateArrayIndex(var, indices);
+
+    // elemen array struct dipakai seperti variabel struct (pointer). @soa dikumpulkan dulu ke alloca sementara
+    if(var->dataType == LiteralType::STRUCT){
+        llvm::StructType* structTy = StructTypes.at(var->structTypeName).type;
+        if(!isSoaArray(var)) return builder.CreateInBoundsGEP(structTy, getArrayDataPtr(var), linear, accessStmt->array_name + "_elem");
+        llvm::AllocaInst* tmp = createEntryBlockAlloca(builder.GetInsertBlock()->getParent(), accessStmt->array_name + "_elem", structTy);
+        builder.CreateStore(loadStructElement(var, linear), tmp);
+        return tmp;
+    }
+
+    // load elemen (array bool: ambil 1 bit dari word-nya)
+    return loadArrayLanes(var, getArrayDataPtr(var), linear, 1);
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "../../include/CodeGen.hpp"
+
+// index linear elemen (sudah bounds check), dipakai loadArrayLanes / storeArrayLanes
+llvm::Value* CodeGen::generateArrayIndex(VarInfo* var, const std::vector<llvm::Value*>& indices){
+    size_t rank = getArrayRank(var);
+    if(indices.size() != rank)
+        throw std::runtime_error("Array has " + std::to_string(rank) + " dimension(s), got " + std::to_string(indices.size()) + " index");
+
+    // row-major: linear = ((i0 * d1 + i1) * d2 + i2) ..., index terakhir stride 1
+    // bounds check semua dimensi digabung jadi satu kondisi -> satu branch
+    llvm::Value* linear = nullptr;
+    llvm::Value* outOfBounds = nullptr;
+    for(size_t d = 0; d < rank; d++){
+        llvm::Value* idx = builder.CreateSExtOrTrunc(indices[d], builder.getInt64Ty(), "idx");
+        llvm::Value* dim = getArrayDim(var, d);
+
+        llvm::Value* bad = builder.CreateICmpUGE(idx, dim, "oobcheck");
+        outOfBounds = outOfBounds ? builder.CreateOr(outOfBounds, bad) : bad;
+
+        // hasil pasti di dalam array setelah bounds check, jadi aman diberi nsw/nuw
+        linear = linear ? builder.CreateAdd(builder.CreateMul(linear, dim, "", true, true), idx, "linidx", true, true) : idx;
+    }
+    genRuntimeError(outOfBounds, "Runtime Error: Array index out of bounds");
+    return linear;
+}
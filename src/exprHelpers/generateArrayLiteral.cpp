@@ -1,37 +1,92 @@
 #include "../../include/CodeGen.hpp"
 
-llvm::Value* CodeGen::generateArrayLiteral(const std::shared_ptr<ArrayLiteralStmt>& arrStmt){
-    if(arrStmt->elements.empty()) throw std::runtime_error("Array tidak boleh kosong");
-    // ambil elemen pertama
-    auto firstEl = arrStmt->elements[0];
-    llvm::Value *firstVal = generateExpression(firstEl);
-    llvm::Type *elType = firstVal->getType();
-    
-    // validasi semua elemen tipenya sama
-    for(size_t i = 0; i < arrStmt->elements.size(); i++){
-        llvm::Value *val = generateExpression(arrStmt->elements[i]);
-        if(val->getType() != elType){
+// literal bersarang [[1, 2], [3, 4]] disimpan rata (row-major) dalam satu [N x T]
+// elemType diisi kalau tipe elemen sudah ditentukan (var a: f32 = [...]), selain itu ikut elemen
+// resultType (opsional) diisi tipe elemen hasil, array bool datanya berupa word i64
+llvm::Value* CodeGen::generateArrayLiteral(const std::shared_ptr<ArrayLiteralStmt>& arrStmt, LiteralType elemType, LiteralType* resultType){
+    std::vector<size_t> shape = arrayLiteralShape(arrStmt);
+
+    // kumpulkan elemen paling dalam sesuai urutan memori
+    std::vector<std::shared_ptr<Stmt>> leaves;
+    std::function<void(const std::shared_ptr<ArrayLiteralStmt>&, size_t)> flatten =
+        [&](const std::shared_ptr<ArrayLiteralStmt>& lit, size_t depth){
+            for(const auto& el : lit->elements){
+                if(depth + 1 < shape.size()) flatten(std::static_pointer_cast<ArrayLiteralStmt>(el), depth + 1);
+                else leaves.push_back(el);
+            }
+        };
+    flatten(arrStmt, 0);
+
+    // tiap elemen di-generate sekali saja
+    std::vector<llvm::Value*> values;
+    values.reserve(leaves.size());
+    for(const auto& leaf : leaves) values.push_back(generateExpression(leaf));
+
+    // validasi semua elemen tipenya sama; literal angka ikut tipe elemen lain ([x, 1.5] dengan x f32),
+    // kalau isinya literal semua dipakai tipe terlebar ([1, 2.5] jadi double)
+    auto isLiteral = [](const std::shared_ptr<Stmt>& e){
+        if(e->type == StmtType::UnaryOp) return std::static_pointer_cast<UnaryOpStmt>(e)->operand->type == StmtType::Literal;
+        return e->type == StmtType::Literal;
+    };
+    llvm::Type *elemTy = elemType == LiteralType::UNKNOWN ? nullptr : literalTypeToLLVM(elemType);
+    llvm::Type *elType = elemTy;
+    bool elemUnsigned = isUnsignedType(elemType);
+    bool allLiteral = std::all_of(leaves.begin(), leaves.end(), isLiteral);
+    for(size_t i = 0; !elType && i < values.size(); i++)
+        if(!isLiteral(leaves[i])) { elType = values[i]->getType(); elemUnsigned = isUnsignedValue(values[i]); }
+    if(!elType){
+        elType = values[0]->getType();
+        for(llvm::Value* val : values)
+            if(elType != strType && val->getType() != strType) elType = promoteBinaryType(elType, val->getType());
+    }
+    for(size_t i = 0; i < values.size(); i++){
+        if(elemTy || (allLiteral && values[i]->getType() != strType && elType != strType))
+            values[i] = castToType(values[i], elType, isUnsignedType(elemType));
+        else values[i] = adaptLiteral(leaves[i], values[i], elType, elemUnsigned);
+        if(values[i]->getType() != elType){
             throw std::runtime_error("Tipe data tidak sama");
         }
     }
-    
-    // buat array type
-    llvm::ArrayType *arrType = llvm::ArrayType::get(elType, arrStmt->elements.size());
-    
-    // alokasi alamat di stack
-    llvm::Function *currentFunc = builder.GetInsertBlock()->getParent();
-    llvm::AllocaInst *allocArr = createEntryBlockAlloca(currentFunc, "arrLit", arrType);
-    
+
+    if(resultType) *resultType = inferLiteralTypeFromLLVM(elType, elemUnsigned);
+
+    // bool dipadatkan 64 elemen per word i64, word dirakit dari bit-bitnya (literal jadi konstanta)
+    bool isBits = elType->isIntegerTy(1);
+    if(isBits){
+        std::vector<llvm::Value*> words((values.size() + 63) / 64);
+        for(size_t w = 0; w < words.size(); w++){
+            llvm::Value *word = builder.getInt64(0);
+            for(size_t b = 0; b < 64 && w * 64 + b < values.size(); b++){
+                llvm::Value *bit = builder.CreateZExt(values[w * 64 + b], builder.getInt64Ty());
+                word = builder.CreateOr(word, builder.CreateShl(bit, b));
+            }
+            words[w] = word;
+        }
+        values = words;
+        elType = builder.getInt64Ty();
+    }
+
+    // buat array type, di top-level berupa global (lihat createVariableStorage)
+    llvm::ArrayType *arrType = llvm::ArrayType::get(elType, values.size());
+    llvm::Value *allocArr = createVariableStorage(isBits ? "bitLit" : "arrLit", arrType);
+
+    // semua elemen konstan: isi global langsung jadi initializer, tanpa store
+    std::vector<llvm::Constant*> constants;
+    for(llvm::Value* val : values)
+        if(auto* constant = llvm::dyn_cast<llvm::Constant>(val)) constants.push_back(constant);
+    if(constants.size() == values.size() && llvm::isa<llvm::GlobalVariable>(allocArr)){
+        storeInitialValue(allocArr, llvm::ConstantArray::get(arrType, constants));
+        return allocArr;
+    }
+
     // simpan elemen
-    for(size_t i = 0; i < arrStmt->elements.size(); i++){
+    for(size_t i = 0; i < values.size(); i++){
         llvm::Value *zero = llvm::ConstantInt::get(builder.getInt32Ty(), 0);
         llvm::Value *idx = llvm::ConstantInt::get(builder.getInt32Ty(), i);
         
         llvm::Value *elPtr = builder.CreateGEP(arrType, allocArr, {zero, idx});
-        llvm::Value *elVal = generateExpression(arrStmt->elements[i]);
-    
-        builder.CreateStore(elVal, elPtr);
+        builder.CreateStore(values[i], elPtr);
     }
     
     return allocArr;
-}
\ No newline at end of file
+}
@@ -29,23 +29,64 @@
 
 
 llvm::Value* CodeGen::generateBinary(const std::shared_ptr<BinaryOpStmt>& binOp) {
+    if(binOp->op == "&&" || binOp->op == "||") return generateLogical(binOp);
     llvm::Value* left = generateExpression(binOp->left);
     llvm::Value* right = generateExpression(binOp->right);
+    left = adaptLiteral(binOp->left, left, right->getType(), isUnsignedValue(right));
+    right = adaptLiteral(binOp->right, right, left->getType(), isUnsignedValue(left));
 
+    // jika string, bandingkan panjang dulu baru isi
+    if(left->getType() == strType){
+        if(binOp->op == "==") return generateStringEq(left, right);
+        if(binOp->op == "!=") return builder.CreateNot(generateStringEq(left, right), "strne");
+    }
+    return emitBinaryOp(binOp->op, left, right);
+}
 
-    // cek tipe float
-    bool isFloat = left->getType()->isDoubleTy() || right->getType()->isDoubleTy();
-    if(isFloat){
-        if(!left->getType()->isDoubleTy()) left = builder.CreateSIToFP(left, llvm::Type::getDoubleTy(context), "leftfp");
-        if(!right->getType()->isDoubleTy()) right = builder.CreateSIToFP(right, llvm::Type::getDoubleTy(context), "rightfp");
+// tipe hasil operasi aritmatika: float menang atas int, lalu yang lebih lebar
+llvm::Type* CodeGen::promoteBinaryType(llvm::Type* left, llvm::Type* right){
+    if(left == right) return left;
+    if(left->isFloatingPointTy() || right->isFloatingPointTy()){
+        if(!left->isFloatingPointTy()) return right;
+        if(!right->isFloatingPointTy()) return left;
+        return left->getPrimitiveSizeInBits() >= right->getPrimitiveSizeInBits() ? left : right;
     }
+    if(left->isIntegerTy() && right->isIntegerTy())
+        return left->getIntegerBitWidth() >= right->getIntegerBitWidth() ? left : right;
+    throw std::runtime_error("Operand types are not compatible");
+}
+
+// operasi biner untuk nilai skalar maupun vector (<N x T>, dipakai operasi array elementwise)
+llvm::Value* CodeGen::emitBinaryOp(const std::string& op, llvm::Value* left, llvm::Value* right){
+    llvm::Type* leftTy = left->getType();
+    llvm::Type* rightTy = right->getType();
+    llvm::Type* common = promoteBinaryType(leftTy->getScalarType(), rightTy->getScalarType());
+    if(auto vecTy = llvm::dyn_cast<llvm::FixedVectorType>(leftTy->isVectorTy() ? leftTy : rightTy))
+        common = llvm::FixedVectorType::get(common, vecTy->getNumElements());
+
+    // unsigned kalau operand yang menentukan lebar hasil unsigned (u32 + i32 -> u32, u8 + i32 -> i32)
+    bool isUnsigned = false;
+    if(common->isIntOrIntVectorTy() && !common->isIntOrIntVectorTy(1)){
+        unsigned width = common->getScalarSizeInBits();
+        isUnsigned = (isUnsignedValue(left) && leftTy->getScalarSizeInBits() == width) ||
+                     (isUnsignedValue(right) && rightTy->getScalarSizeInBits() == width);
+    }
+    if(leftTy != common) left = castToType(left, common);
+    if(rightTy != common) right = castToType(right, common);
+
+    bool isFloat = common->isFPOrFPVectorTy();
 
     // handle operator
-    if(binOp->op == "+") return isFloat ? builder.CreateFAdd(left, right, "faddtmp") : builder.CreateAdd(left, right, "addtmp");
-    else if(binOp->op == "-") return isFloat ? builder.CreateFSub(left, right, "fsubtmp") : builder.CreateSub(left, right, "subtmp");
-    else if(binOp->op == "*") return isFloat ? builder.CreateFMul(left, right, "fmultmp") : builder.CreateMul(left, right, "multtmp");
-    else if(binOp->op == "/") return isFloat ? builder.CreateFDiv(left, right, "fdivtmp") : builder.CreateSDiv(left, right, "divtmp");
-    else if(binOp->op == "%") {
+    if(op == "+") return isFloat ? builder.CreateFAdd(left, right, "faddtmp") : markUnsigned(builder.CreateAdd(left, right, "addtmp"), isUnsigned);
+    else if(op == "-") return isFloat ? builder.CreateFSub(left, right, "fsubtmp") : markUnsigned(builder.CreateSub(left, right, "subtmp"), isUnsigned);
+    else if(op == "*") return isFloat ? builder.CreateFMul(left, right, "fmultmp") : markUnsigned(builder.CreateMul(left, right, "multtmp"), isUnsigned);
+    else if(op == "/") {
+        if(isFloat) return builder.CreateFDiv(left, right, "fdivtmp");
+        return isUnsigned ? markUnsigned(builder.CreateUDiv(left, right, "udivtmp")) : builder.CreateSDiv(left, right, "divtmp");
+    }
+    else if(op == "%") {
+        // frem = fmod, dipakai untuk vector (dan selain f64) supaya tidak jadi call per elemen
+        if(isFloat && !common->isDoubleTy()) return builder.CreateFRem(left, right, "fmodtmp");
         if(isFloat){
             llvm::FunctionType* fmodType = llvm::FunctionType::get(
                 llvm::Type::getDoubleTy(context),
@@ -53,33 +94,69 @@ llvm::Value* CodeGen::generateBinary(const std::shared_ptr<BinaryOpStmt>& binOp)
                 false);
             llvm::FunctionCallee fmodFunc = module->getOrInsertFunction("fmod", fmodType);
             return builder.CreateCall(fmodFunc, {left, right}, "fmodtmp");
-        } else return builder.CreateSRem(left, right, "modtmp");
+        }
+        return isUnsigned ? markUnsigned(builder.CreateURem(left, right, "umodtmp")) : builder.CreateSRem(left, right, "modtmp");
     }
-    else if(binOp->op == "==") {
-        // jika string (i8*), pakai strcmp
-        if(left->getType()->isPointerTy() && left->getType()->getPointerElementType()->isIntegerTy(8))
-            return generateStringEq(left, right);
-        else return isFloat ? builder.CreateFCmpOEQ(left, right, "feqtmp") : builder.CreateICmpEQ(left, right, "eqtmp");
+    else if(op == "&" || op == "|" || op == "^") {
+        // integer bitwise, bool (juga and / or / xor array bool per elemen)
+        if(isFloat) throw std::runtime_error("Operator " + op + " needs integer or bool operands");
+        if(op == "&") return markUnsigned(builder.CreateAnd(left, right, "andtmp"), isUnsigned);
+        if(op == "|") return markUnsigned(builder.CreateOr(left, right, "ortmp"), isUnsigned);
+        return markUnsigned(builder.CreateXor(left, right, "xortmp"), isUnsigned);
     }
-    else if(binOp->op == "!=") {
-        if(left->getType()->isPointerTy() && left->getType()->getPointerElementType()->isIntegerTy(8))
-            return builder.CreateNot(generateStringEq(left, right), "strne");
-        else return isFloat ? builder.CreateFCmpONE(left, right, "fnetmp") : builder.CreateICmpNE(left, right, "netmp");
+    else if(op == "<<" || op == ">>") {
+        // jumlah geser di-mask ke lebar tipe (x << 33 di i32 = x << 1, seperti shl x86), tidak pernah poison.
+        // >> aritmatika untuk signed, logika untuk unsigned
+        if(isFloat || common->isIntOrIntVectorTy(1)) throw std::runtime_error("Operator " + op + " needs integer operands");
+        right = builder.CreateAnd(right, llvm::ConstantInt::get(common, common->getScalarSizeInBits() - 1), "shamt");
+        if(op == "<<") return markUnsigned(builder.CreateShl(left, right, "shltmp"), isUnsigned);
+        return isUnsigned ? markUnsigned(builder.CreateLShr(left, right, "lshrtmp")) : builder.CreateAShr(left, right, "ashrtmp");
     }
-    else if(binOp->op == "<") return isFloat ? builder.CreateFCmpOLT(left, right, "flttmp") : builder.CreateICmpSLT(left, right, "lttmp");
-    else if(binOp->op == "<=") return isFloat ? builder.CreateFCmpOLE(left, right, "fletmp") : builder.CreateICmpSLE(left, right, "letmp");
-    else if(binOp->op == ">") return isFloat ? builder.CreateFCmpOGT(left, right, "fgttmp") : builder.CreateICmpSGT(left, right, "gttmp");
-    else if(binOp->op == ">=") return isFloat ? builder.CreateFCmpOGE(left, right, "fgettmp") : builder.CreateICmpSGE(left, right, "getmp");
+    else if(op == "==") return isFloat ? builder.CreateFCmpOEQ(left, right, "feqtmp") : builder.CreateICmpEQ(left, right, "eqtmp");
+    else if(op == "!=") return isFloat ? builder.CreateFCmpONE(left, right, "fnetmp") : builder.CreateICmpNE(left, right, "netmp");
+    else if(op == "<") return isFloat ? builder.CreateFCmpOLT(left, right, "flttmp") : isUnsigned ? builder.CreateICmpULT(left, right, "lttmp") : builder.CreateICmpSLT(left, right, "lttmp");
+    else if(op == "<=") return isFloat ? builder.CreateFCmpOLE(left, right, "fletmp") : isUnsigned ? builder.CreateICmpULE(left, right, "letmp") : builder.CreateICmpSLE(left, right, "letmp");
+    else if(op == ">") return isFloat ? builder.CreateFCmpOGT(left, right, "fgttmp") : isUnsigned ? builder.CreateICmpUGT(left, right, "gttmp") : builder.CreateICmpSGT(left, right, "gttmp");
+    else if(op == ">=") return isFloat ? builder.CreateFCmpOGE(left, right, "fgettmp") : isUnsigned ? builder.CreateICmpUGE(left, right, "getmp") : builder.CreateICmpSGE(left, right, "getmp");
 
-    throw std::runtime_error("Binary operator tidak dikenali: " + binOp->op);
+    throw std::runtime_error("Binary operator tidak dikenali: " + op);
 }
 
 // helper function untuk string comparison
+// panjang beda -> false, pointer sama (literal di-intern) -> true, sisanya baru memcmp
 llvm::Value* CodeGen::generateStringEq(llvm::Value* lhs, llvm::Value* rhs){
-    auto strcmpFunc = module->getOrInsertFunction("strcmp",
+    if(rhs->getType() != strType)
+        throw std::runtime_error("Cannot compare str with non-str value");
+
+    llvm::Value* lhsPtr = builder.CreateExtractValue(lhs, 0, "lhsptr");
+    llvm::Value* lhsLen = builder.CreateExtractValue(lhs, 1, "lhslen");
+    llvm::Value* rhsPtr = builder.CreateExtractValue(rhs, 0, "rhsptr");
+    llvm::Value* rhsLen = builder.CreateExtractValue(rhs, 1, "rhslen");
+
+    llvm::Function* parentFunc = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* lenBB = builder.GetInsertBlock();
+    llvm::BasicBlock* ptrBB = llvm::BasicBlock::Create(context, "streq_ptr", parentFunc);
+    llvm::BasicBlock* cmpBB = llvm::BasicBlock::Create(context, "streq_cmp", parentFunc);
+    llvm::BasicBlock* doneBB = llvm::BasicBlock::Create(context, "streq_done", parentFunc);
+
+    builder.CreateCondBr(builder.CreateICmpEQ(lhsLen, rhsLen, "lenEq"), ptrBB, doneBB);
+
+    builder.SetInsertPoint(ptrBB);
+    builder.CreateCondBr(builder.CreateICmpEQ(lhsPtr, rhsPtr, "ptrEq"), doneBB, cmpBB);
+
+    builder.SetInsertPoint(cmpBB);
+    auto memcmpFunc = module->getOrInsertFunction("memcmp",
         llvm::FunctionType::get(builder.getInt32Ty(),
-                                {builder.getInt8PtrTy(), builder.getInt8PtrTy()},
+                                {builder.getInt8PtrTy(), builder.getInt8PtrTy(), builder.getInt64Ty()},
                                 false));
-    llvm::Value* result = builder.CreateCall(strcmpFunc, {lhs, rhs}, "strcmptmp");
-    return builder.CreateICmpEQ(result, llvm::ConstantInt::get(builder.getInt32Ty(), 0), "streqtmp");
+    llvm::Value* result = builder.CreateCall(memcmpFunc, {lhsPtr, rhsPtr, lhsLen}, "memcmptmp");
+    llvm::Value* bytesEq = builder.CreateICmpEQ(result, builder.getInt32(0), "streqtmp");
+    builder.CreateBr(doneBB);
+
+    builder.SetInsertPoint(doneBB);
+    llvm::PHINode* phi = builder.CreatePHI(builder.getInt1Ty(), 3, "streq");
+    phi->addIncoming(builder.getFalse(), lenBB);
+    phi->addIncoming(builder.getTrue(), ptrBB);
+    phi->addIncoming(bytesEq, cmpBB);
+    return phi;
 }
@@ -0,0 +1,56 @@
+#include "../../include/CodeGen.hpp"
+
+// count(m), any(m), all(m) untuk array bool yang dipadatkan 64 elemen per word i64:
+// dihitung per word (popcount / or / and), bukan per elemen.
+// and(a, b), or(a, b), xor(a, b) dikerjakan generateElementwise (hasilnya array baru)
+llvm::Value* CodeGen::generateBitArrayBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    const std::string& name = callStmt->name;
+    if(name == "and" || name == "or" || name == "xor")
+        throw std::runtime_error(name + " on arrays must be assigned to a variable, e.g. var c = " + name + "(a, b);");
+    if(callStmt->args.size() != 1)
+        throw std::runtime_error(name + " expects 1 bool array argument");
+
+    auto target = std::dynamic_pointer_cast<IdentifierStmt>(callStmt->args[0]);
+    VarInfo* var = target ? lookupVariable(target->name) : nullptr;
+    if(!var || !isBitArray(var))
+        throw std::runtime_error(name + " expects a bool array variable");
+    return emitBitReduce(var, name);
+}
+
+
+
+// kind: count (i64), any / all (bool). word terakhir yang tidak penuh di-mask,
+// bit sisa di atas len (misal setelah pop) tidak ikut dihitung
+llvm::Value* CodeGen::emitBitReduce(const VarInfo* var, const std::string& kind){
+    llvm::Type* wordTy = builder.getInt64Ty();
+    llvm::Value* data = getArrayDataPtr(var);
+    llvm::Value* n = getArrayLength(var);
+    llvm::Value* fullWords = builder.CreateLShr(n, 6, "fullwords");
+    llvm::Value* words = bitWordCount(n);
+    llvm::Value* tailMask = builder.CreateSub(builder.CreateShl(builder.getInt64(1), builder.CreateAnd(n, 63)), builder.getInt64(1), "tailmask");
+
+    llvm::Value* init = builder.getInt64(kind == "all" ? -1 : 0);
+    auto combine = [&](llvm::Value* acc, llvm::Value* word){
+        if(kind == "count") return builder.CreateAdd(acc, builder.CreateUnaryIntrinsic(llvm::Intrinsic::ctpop, word));
+        if(kind == "any") return builder.CreateOr(acc, word);
+        return builder.CreateAnd(acc, word);
+    };
+    auto load = [&](llvm::Value* w){ return builder.CreateLoad(wordTy, builder.CreateInBoundsGEP(wordTy, data, w)); };
+
+    auto acc = emitCountedLoop(builder.getInt64(0), fullWords, 1, "bits_" + kind, {init},
+        [&](llvm::Value* w, const std::vector<llvm::Value*>& c){
+            return std::vector<llvm::Value*>{ combine(c[0], load(w)) };
+        });
+    // paling banyak 1 iterasi: word terakhir yang hanya terisi sebagian
+    acc = emitCountedLoop(fullWords, words, 1, "bits_tail", acc,
+        [&](llvm::Value* w, const std::vector<llvm::Value*>& c){
+            llvm::Value* word = load(w);
+            // all: bit di luar len dianggap 1 supaya tidak menggagalkan
+            word = kind == "all" ? builder.CreateOr(word, builder.CreateNot(tailMask)) : builder.CreateAnd(word, tailMask);
+            return std::vector<llvm::Value*>{ combine(c[0], word) };
+        });
+
+    if(kind == "count") return acc[0];
+    if(kind == "any") return builder.CreateICmpNE(acc[0], builder.getInt64(0), "any");
+    return builder.CreateICmpEQ(acc[0], builder.getInt64(-1), "all");
+}
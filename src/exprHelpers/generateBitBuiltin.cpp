@@ -0,0 +1,35 @@
+#include "../../include/CodeGen.hpp"
+
+// popcount(x), clz(x), ctz(x), bswap(x), rotl(x, n), rotr(x, n) untuk integer skalar,
+// langsung jadi intrinsic llvm (popcnt / lzcnt / tzcnt / bswap / rol di x86). hasilnya bertipe sama dengan x
+llvm::Value* CodeGen::generateBitBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    const std::string& name = callStmt->name;
+    bool rotate = name == "rotl" || name == "rotr";
+    if(callStmt->args.size() != (rotate ? 2u : 1u))
+        throw std::runtime_error(name + (rotate ? " expects (value, amount)" : " expects 1 integer argument"));
+
+    llvm::Value* x = generateExpression(callStmt->args[0]);
+    llvm::Type* ty = x->getType();
+    if(!ty->isIntegerTy() || ty->isIntegerTy(1))
+        throw std::runtime_error(name + " expects an integer argument");
+    bool isUnsigned = isUnsignedValue(x);
+
+    llvm::Value* result = nullptr;
+    if(name == "popcount") result = builder.CreateUnaryIntrinsic(llvm::Intrinsic::ctpop, x, nullptr, "popcount");
+    // x = 0 menghasilkan lebar tipe (clz(0 as u32) = 32), bukan poison
+    else if(name == "clz") result = builder.CreateBinaryIntrinsic(llvm::Intrinsic::ctlz, x, builder.getFalse(), nullptr, "clz");
+    else if(name == "ctz") result = builder.CreateBinaryIntrinsic(llvm::Intrinsic::cttz, x, builder.getFalse(), nullptr, "ctz");
+    else if(name == "bswap"){
+        if(ty->getIntegerBitWidth() == 8) return x; // satu byte, tidak ada yang ditukar
+        result = builder.CreateUnaryIntrinsic(llvm::Intrinsic::bswap, x, nullptr, "bswap");
+    }
+    else {
+        // rotasi = funnel shift dengan kedua input x, jumlah putaran otomatis modulo lebar tipe
+        llvm::Value* amount = generateExpression(callStmt->args[1]);
+        if(!amount->getType()->isIntegerTy() || amount->getType()->isIntegerTy(1))
+            throw std::runtime_error(name + ": amount must be an integer");
+        if(amount->getType() != ty) amount = castToType(amount, ty);
+        result = builder.CreateIntrinsic(name == "rotl" ? llvm::Intrinsic::fshl : llvm::Intrinsic::fshr, {ty}, {x, x, amount}, nullptr, name);
+    }
+    return markUnsigned(result, isUnsigned);
+}
@@ -0,0 +1,67 @@
+#include "../../include/CodeGen.hpp"
+
+// fungsi bawaan yang tidak dideklarasikan user
+// return nullptr kalau nama bukan builtin, nanti generateFunctionCall yang lempar error
+llvm::Value* CodeGen::generateBuiltinCall(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    const std::string& name = callStmt->name;
+
+    if(name == "save") return generateSaveLoad(callStmt, true);
+    if(name == "load") return generateSaveLoad(callStmt, false);
+    if(name == "len") return generateLen(callStmt);
+    if(name == "shape") return generateShape(callStmt);
+    if(name == "push" || name == "pop" || name == "reserve") return generateDynArrayBuiltin(callStmt);
+    if(name == "sum" || name == "sum_fast" || name == "min" || name == "max" ||
+        name == "dot" || name == "dot_fast" || name == "argmin" || name == "argmax")
+        return generateReduction(callStmt);
+    if((name == "count" && callStmt->args.size() == 1) || name == "any" || name == "all" ||
+        name == "and" || name == "or" || name == "xor")
+        return generateBitArrayBuiltin(callStmt);
+    if(name == "popcount" || name == "clz" || name == "ctz" || name == "bswap" || name == "rotl" || name == "rotr")
+        return generateBitBuiltin(callStmt);
+    if(name == "slice" || name == "substr" || name == "find" || name == "count" ||
+        name == "split" || name == "starts_with" || name == "ends_with")
+        return generateStringBuiltin(callStmt);
+
+    return nullptr;
+}
+
+
+
+// len(x): panjang str atau ukuran dimensi pertama array (jumlah baris untuk matrix), hasilnya i64
+llvm::Value* CodeGen::generateLen(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    if(callStmt->args.size() != 1)
+        throw std::runtime_error("len expects 1 argument");
+
+    auto arg = callStmt->args[0];
+    if(arg->type == StmtType::Identifier){
+        VarInfo* var = lookupVariable(std::static_pointer_cast<IdentifierStmt>(arg)->name);
+        if(var && var->isArray) return getArrayDim(var, 0);
+    }
+
+    llvm::Value* val = generateExpression(arg);
+    if(val->getType() != strType)
+        throw std::runtime_error("len expects a str or array");
+    return builder.CreateExtractValue(val, 1, "len");
+}
+
+
+
+// shape(m, k): ukuran dimensi ke-k array, k harus literal integer
+llvm::Value* CodeGen::generateShape(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    if(callStmt->args.size() != 2)
+        throw std::runtime_error("shape expects (array, dimension)");
+
+    auto target = std::dynamic_pointer_cast<IdentifierStmt>(callStmt->args[0]);
+    VarInfo* var = target ? lookupVariable(target->name) : nullptr;
+    if(!var || !var->isArray)
+        throw std::runtime_error("shape: first argument must be an array variable");
+
+    auto dimLit = std::dynamic_pointer_cast<LiteralStmt>(callStmt->args[1]);
+    if(!dimLit || dimLit->dataType != LiteralType::INT_32)
+        throw std::runtime_error("shape: dimension must be an integer literal");
+
+    int32_t dim = std::get<int32_t>(dimLit->value);
+    if(dim < 0 || static_cast<size_t>(dim) >= getArrayRank(var))
+        throw std::runtime_error("shape: array has no dimension " + std::to_string(dim));
+    return getArrayDim(var, dim);
+}
@@ -0,0 +1,177 @@
+#include "../../include/CodeGen.hpp"
+
+// array<T>(n) / array<T>(d0, d1, ...): alokasi semua elemen (diisi 0) sekaligus dalam satu blok,
+// hasilnya header { data, len = total, cap = total } (+ ukuran tiap dimensi)
+llvm::Value* CodeGen::generateDynArray(const std::shared_ptr<DynArrayExpr>& dynStmt){
+    if(dynStmt->elemType == LiteralType::UNKNOWN)
+        throw std::runtime_error("Unknown element type for dynamic array");
+
+    size_t rank = dynStmt->sizes.empty() ? 1 : dynStmt->sizes.size();
+    // array<bool>: data berupa word i64 (64 elemen per word), cap dihitung dalam bit
+    bool isBits = dynStmt->elemType == LiteralType::BOOL;
+    // array<Point>: elemen struct berurutan, @soa: blok byte berisi satu kolom per field (cap kelipatan 8)
+    bool isSoa = false;
+    llvm::Type* elemTy = nullptr;
+    if(!dynStmt->structName.empty()){
+        auto found = StructTypes.find(dynStmt->structName);
+        if(found == StructTypes.end()) throw std::runtime_error("Unknown struct type: " + dynStmt->structName);
+        if(rank > 1) throw std::runtime_error("Arrays of structs must be one-dimensional");
+        isSoa = found->second.soa;
+        elemTy = found->second.type;
+    }
+    else elemTy = isBits ? builder.getInt64Ty() : literalTypeToLLVM(dynStmt->elemType);
+    llvm::StructType* headerTy = getDynArrayType(isSoa ? builder.getInt8Ty() : elemTy, rank);
+
+    llvm::Value* len = builder.getInt64(dynStmt->sizes.empty() ? 0 : 1);
+    llvm::Value* negative = builder.getFalse();
+    std::vector<llvm::Value*> dims;
+    for(const auto& sizeExpr : dynStmt->sizes){
+        llvm::Value* dim = generateExpression(sizeExpr);
+        if(!dim->getType()->isIntegerTy() || dim->getType()->isIntegerTy(1))
+            throw std::runtime_error("Dynamic array size must be an integer");
+        dim = builder.CreateSExtOrTrunc(dim, builder.getInt64Ty(), "dynlen");
+        negative = builder.CreateOr(negative, builder.CreateICmpSLT(dim, builder.getInt64(0)));
+        len = builder.CreateMul(len, dim, "dyntotal");
+        dims.push_back(dim);
+    }
+    genRuntimeError(negative, "Runtime Error: Negative array size");
+
+    llvm::FunctionCallee allocFunc = module->getOrInsertFunction("aiko_array_alloc",
+        llvm::FunctionType::get(builder.getInt8PtrTy(), {builder.getInt64Ty(), builder.getInt64Ty()}, false));
+    llvm::Value* count = isBits ? bitWordCount(len) : len;
+    if(isSoa) count = builder.CreateAnd(builder.CreateAdd(len, builder.getInt64(7)), builder.getInt64(~uint64_t(7)), "soacap");
+    llvm::Value* raw = builder.CreateCall(allocFunc, {llvm::ConstantExpr::getSizeOf(elemTy), count}, "dyndata");
+    llvm::Value* data = builder.CreateBitCast(raw, headerTy->getElementType(0));
+
+    llvm::Value* header = llvm::UndefValue::get(headerTy);
+    header = builder.CreateInsertValue(header, data, 0);
+    header = builder.CreateInsertValue(header, len, 1);
+    header = builder.CreateInsertValue(header, isBits ? builder.CreateShl(count, 6) : count, 2);
+    if(rank > 1){
+        for(size_t d = 0; d < rank; d++)
+            header = builder.CreateInsertValue(header, dims[d], {3, static_cast<unsigned>(d)});
+    }
+    return header;
+}
+
+
+
+// push(a, v), pop(a), reserve(a, n) untuk array dinamis
+// jalur cepat (masih ada kapasitas) langsung inline, runtime hanya dipanggil saat harus tumbuh
+llvm::Value* CodeGen::generateDynArrayBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    const std::string& name = callStmt->name;
+    if(callStmt->args.empty())
+        throw std::runtime_error(name + " expects a dynamic array as first argument");
+
+    auto target = std::dynamic_pointer_cast<IdentifierStmt>(callStmt->args[0]);
+    VarInfo* var = target ? lookupVariable(target->name) : nullptr;
+    if(!var || !var->isDynamic)
+        throw std::runtime_error(name + ": first argument must be a dynamic array variable");
+    if(var->isBorrowed)
+        throw std::runtime_error(name + ": " + target->name + " is an array parameter, its size belongs to the caller");
+    if(getArrayRank(var) != 1)
+        throw std::runtime_error(name + ": only one-dimensional arrays can grow");
+
+    llvm::Type* headerTy = var->storageType();
+    llvm::Type* elemTy = getArrayElementType(var);
+    llvm::Value* lenField = builder.CreateStructGEP(headerTy, var->alloc, 1);
+    llvm::Value* capField = builder.CreateStructGEP(headerTy, var->alloc, 2);
+
+    llvm::FunctionCallee growFunc = module->getOrInsertFunction("aiko_array_grow",
+        llvm::FunctionType::get(builder.getVoidTy(), {builder.getInt8PtrTy(), builder.getInt64Ty(), builder.getInt64Ty()}, false));
+    llvm::FunctionCallee growBitsFunc = module->getOrInsertFunction("aiko_bitarray_grow",
+        llvm::FunctionType::get(builder.getVoidTy(), {builder.getInt8PtrTy(), builder.getInt64Ty()}, false));
+    bool isBits = isBitArray(var);
+    bool isStruct = var->dataType == LiteralType::STRUCT;
+
+    // @soa tumbuh lewat aiko_soa_grow dengan tabel ukuran field (global konstan per struct)
+    auto growSoa = [&](llvm::Value* rawHeader, llvm::Value* minCap){
+        auto structTy = llvm::cast<llvm::StructType>(elemTy);
+        std::string tableName = var->structTypeName + ".soa_sizes";
+        llvm::GlobalVariable* table = module->getNamedGlobal(tableName);
+        if(!table){
+            std::vector<llvm::Constant*> sizes;
+            for(llvm::Type* fieldTy : structTy->elements())
+                sizes.push_back(builder.getInt64(module->getDataLayout().getTypeAllocSize(fieldTy).getFixedSize()));
+            auto tableTy = llvm::ArrayType::get(builder.getInt64Ty(), sizes.size());
+            table = new llvm::GlobalVariable(*module, tableTy, true, llvm::GlobalValue::PrivateLinkage,
+                                             llvm::ConstantArray::get(tableTy, sizes), tableName);
+        }
+        llvm::FunctionCallee soaGrowFunc = module->getOrInsertFunction("aiko_soa_grow",
+            llvm::FunctionType::get(builder.getVoidTy(), {builder.getInt8PtrTy(), builder.getInt64Ty()->getPointerTo(),
+                                                          builder.getInt64Ty(), builder.getInt64Ty()}, false));
+        llvm::Value* sizesPtr = builder.CreateConstInBoundsGEP2_32(table->getValueType(), table, 0, 0);
+        builder.CreateCall(soaGrowFunc, {rawHeader, sizesPtr, builder.getInt64(structTy->getNumElements()), minCap});
+    };
+
+    // panggil grow hanya kalau kapasitas kurang dari minCap
+    auto ensureCapacity = [&](llvm::Value* minCap){
+        llvm::Value* cap = builder.CreateLoad(builder.getInt64Ty(), capField, "cap");
+        llvm::Function* func = builder.GetInsertBlock()->getParent();
+        llvm::BasicBlock* growBB = llvm::BasicBlock::Create(context, "dyn_grow", func);
+        llvm::BasicBlock* readyBB = llvm::BasicBlock::Create(context, "dyn_ready", func);
+
+        llvm::Value* full = builder.CreateICmpSGT(minCap, cap, "full");
+        builder.CreateCondBr(full, growBB, readyBB);
+
+        builder.SetInsertPoint(growBB);
+        llvm::Value* rawHeader = builder.CreateBitCast(var->alloc, builder.getInt8PtrTy());
+        if(isBits) builder.CreateCall(growBitsFunc, {rawHeader, minCap});
+        else if(isSoaArray(var)) growSoa(rawHeader, minCap);
+        else builder.CreateCall(growFunc, {rawHeader, llvm::ConstantExpr::getSizeOf(elemTy), minCap});
+        builder.CreateBr(readyBB);
+
+        builder.SetInsertPoint(readyBB);
+    };
+
+    if(name == "push"){
+        if(callStmt->args.size() != 2) throw std::runtime_error("push expects (array, value)");
+        llvm::Value* val = nullptr;
+        if(isStruct){
+            std::string structName;
+            llvm::Value* src = structPointer(callStmt->args[1], structName);
+            if(structName != var->structTypeName)
+                throw std::runtime_error("push: elements of " + target->name + " are " + var->structTypeName);
+            val = builder.CreateLoad(elemTy, src);
+        }
+        else val = castToType(generateExpression(callStmt->args[1]), elemTy);
+
+        llvm::Value* len = builder.CreateLoad(builder.getInt64Ty(), lenField, "len");
+        llvm::Value* newLen = builder.CreateAdd(len, builder.getInt64(1), "newlen");
+        ensureCapacity(newLen);
+
+        if(isStruct) storeStructElement(var, len, val);
+        else storeArrayLanes(var, getArrayDataPtr(var), len, val); // data dibaca ulang, grow bisa memindahkan data
+        builder.CreateStore(newLen, lenField);
+        return newLen;
+    }
+
+    if(name == "pop"){
+        if(callStmt->args.size() != 1) throw std::runtime_error("pop expects (array)");
+        llvm::Value* len = builder.CreateLoad(builder.getInt64Ty(), lenField, "len");
+        genRuntimeError(builder.CreateICmpEQ(len, builder.getInt64(0)), "Runtime Error: pop from empty array");
+
+        llvm::Value* newLen = builder.CreateSub(len, builder.getInt64(1), "newlen");
+        // struct: disalin ke alloca sementara, slot-nya bisa ditimpa push berikutnya
+        if(isStruct){
+            llvm::AllocaInst* tmp = createEntryBlockAlloca(builder.GetInsertBlock()->getParent(), target->name + "_pop", elemTy);
+            builder.CreateStore(loadStructElement(var, newLen), tmp);
+            builder.CreateStore(newLen, lenField);
+            return tmp;
+        }
+        llvm::Value* data = getArrayDataPtr(var);
+        llvm::Value* val = loadArrayLanes(var, data, newLen, 1);
+        builder.CreateStore(newLen, lenField);
+        return val;
+    }
+
+    if(name == "reserve"){
+        if(callStmt->args.size() != 2) throw std::runtime_error("reserve expects (array, capacity)");
+        llvm::Value* want = generateExpression(callStmt->args[1]);
+        if(!want->getType()->isIntegerTy()) throw std::runtime_error("reserve: capacity must be an integer");
+        ensureCapacity(builder.CreateSExtOrTrunc(want, builder.getInt64Ty()));
+        return builder.CreateLoad(builder.getInt64Ty(), capField, "cap");
+    }
+
+    return nullptr;
+}
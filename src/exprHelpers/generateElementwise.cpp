@@ -0,0 +1,248 @@
+#include "../../include/CodeGen.hpp"
+
+// operasi array elementwise: c = a * b + d, a += 1.5, mask = a > b, a = 0
+// seluruh ekspresi jadi satu loop tanpa array sementara: bagian utama pakai vector
+// selebar register SIMD CPU, sisa elemen (kurang dari 1 vector) pakai loop skalar
+
+// operator biner atau and(a, b) / or(a, b) / xor(a, b) (sama dengan operator & | ^, && ||)
+static bool binaryParts(const std::shared_ptr<Stmt>& e, std::string& op, std::shared_ptr<Stmt>& left, std::shared_ptr<Stmt>& right){
+    if(e->type == StmtType::BinaryOp){
+        auto bin = std::static_pointer_cast<BinaryOpStmt>(e);
+        op = bin->op; left = bin->left; right = bin->right;
+        // array bool: && / || per elemen, semua elemen dihitung (tanpa short-circuit)
+        if(op == "&&") op = "&";
+        if(op == "||") op = "|";
+        return true;
+    }
+    if(e->type == StmtType::FunctionCall){
+        auto call = std::static_pointer_cast<FunctionCallStmt>(e);
+        static const std::map<std::string, std::string> logicOps = {{"and", "&"}, {"or", "|"}, {"xor", "^"}};
+        auto it = logicOps.find(call->name);
+        if(it == logicOps.end() || call->args.size() != 2) return false;
+        op = it->second; left = call->args[0]; right = call->args[1];
+        return true;
+    }
+    return false;
+}
+
+// true kalau ekspresi (lewat operator) memakai variabel array tanpa index
+bool CodeGen::isElementwiseExpr(const std::shared_ptr<Stmt>& expr){
+    std::string op;
+    std::shared_ptr<Stmt> left, right;
+    switch(expr->type){
+        case StmtType::Identifier: {
+            VarInfo* var = lookupVariable(std::static_pointer_cast<IdentifierStmt>(expr)->name);
+            return var && var->isArray;
+        }
+        case StmtType::BinaryOp:
+        case StmtType::FunctionCall:
+            return binaryParts(expr, op, left, right) && (isElementwiseExpr(left) || isElementwiseExpr(right));
+        case StmtType::UnaryOp:
+            return isElementwiseExpr(std::static_pointer_cast<UnaryOpStmt>(expr)->operand);
+        default:
+            return false;
+    }
+}
+
+
+
+void CodeGen::generateElementwise(const std::string& targetName, const std::shared_ptr<Stmt>& expr, bool declare){
+    struct Operand {
+        VarInfo* var;
+        llvm::Value* data;
+        llvm::Type* elemTy;
+    };
+    std::map<std::string, Operand> arrays;
+    std::map<const Stmt*, llvm::Value*> scalars; // sub-ekspresi tanpa array, dihitung sekali sebelum loop
+    std::map<const Stmt*, bool> unsignedNodes;    // hasil sub-ekspresi bertipe unsigned
+
+    auto addArray = [&](VarInfo* var){
+        llvm::Type* elemTy = getArrayElementType(var);
+        if(!elemTy->isIntegerTy() && !elemTy->isFloatingPointTy())
+            throw std::runtime_error("Elementwise operations need numeric or bool arrays");
+        return Operand{var, getArrayDataPtr(var), elemTy};
+    };
+
+    // tahap 1: kumpulkan operand array, hoist skalar, hitung tipe hasil per elemen
+    std::function<llvm::Type*(const std::shared_ptr<Stmt>&)> prepare = [&](const std::shared_ptr<Stmt>& e) -> llvm::Type* {
+        std::string op;
+        std::shared_ptr<Stmt> left, right;
+        if(binaryParts(e, op, left, right) && isElementwiseExpr(e)){
+            llvm::Type* l = prepare(left);
+            llvm::Type* r = prepare(right);
+            // a * 2.5 dengan a array f32: literal ikut f32 supaya lane tidak jadi setengah
+            auto adapt = [&](const std::shared_ptr<Stmt>& side, llvm::Type*& ty, llvm::Type* other, bool otherUnsigned){
+                auto hoisted = scalars.find(side.get());
+                if(hoisted == scalars.end()) return;
+                hoisted->second = adaptLiteral(side, hoisted->second, other, otherUnsigned);
+                ty = hoisted->second->getType();
+            };
+            adapt(left, l, r, unsignedNodes[right.get()]);
+            adapt(right, r, l, unsignedNodes[left.get()]);
+            static const std::set<std::string> comparisons = {"==", "!=", "<", "<=", ">", ">="};
+            if(comparisons.count(op)) return builder.getInt1Ty();
+            // aturan unsigned sama dengan emitBinaryOp
+            llvm::Type* common = promoteBinaryType(l, r);
+            unsignedNodes[e.get()] = common->isIntegerTy() && !common->isIntegerTy(1) &&
+                ((unsignedNodes[left.get()] && l == common) || (unsignedNodes[right.get()] && r == common));
+            return common;
+        }
+        if(e->type == StmtType::UnaryOp && isElementwiseExpr(e)){
+            auto un = std::static_pointer_cast<UnaryOpStmt>(e);
+            llvm::Type* t = prepare(un->operand);
+            unsignedNodes[e.get()] = un->op != "!" && unsignedNodes[un->operand.get()];
+            return un->op == "!" ? builder.getInt1Ty() : t;
+        }
+        if(e->type == StmtType::Identifier && isElementwiseExpr(e)){
+            const std::string& name = std::static_pointer_cast<IdentifierStmt>(e)->name;
+            if(!arrays.count(name)) arrays.emplace(name, addArray(lookupVariable(name)));
+            unsignedNodes[e.get()] = isUnsignedType(arrays.at(name).var->dataType);
+            return arrays.at(name).elemTy;
+        }
+        llvm::Value* val = generateExpression(e);
+        if(!val->getType()->isIntegerTy() && !val->getType()->isFloatingPointTy())
+            throw std::runtime_error("Only numbers and bools can be combined with whole arrays");
+        scalars[e.get()] = val;
+        unsignedNodes[e.get()] = isUnsignedValue(val);
+        return val->getType();
+    };
+    llvm::Type* resultTy = prepare(expr);
+
+    // target: array yang sudah ada, atau array baru dengan shape operand pertama
+    VarInfo* target = nullptr;
+    if(declare){
+        if(arrays.empty()) throw std::runtime_error("Elementwise expression has no array operand");
+        VarInfo* like = arrays.begin()->second.var;
+        llvm::Value* n = getArrayLength(like);
+        VarInfo info;
+        // hasil bool disimpan sebagai word i64 (64 elemen per word)
+        bool isBits = resultTy->isIntegerTy(1);
+        llvm::Type* storageTy = isBits ? builder.getInt64Ty() : resultTy;
+        if(like->isDynamic){
+            // data baru dari arena (tanpa diisi 0, semua elemen langsung ditulis loop)
+            size_t rank = getArrayRank(like);
+            llvm::StructType* headerTy = getDynArrayType(storageTy, rank);
+            llvm::FunctionCallee allocFunc = module->getOrInsertFunction("aiko_arena_alloc",
+                llvm::FunctionType::get(builder.getInt8PtrTy(), {builder.getInt64Ty()}, false));
+            llvm::Value* count = isBits ? bitWordCount(n) : n;
+            llvm::Value* bytes = builder.CreateMul(count, llvm::ConstantExpr::getSizeOf(storageTy));
+            llvm::Value* data = builder.CreateBitCast(builder.CreateCall(allocFunc, {bytes}), storageTy->getPointerTo());
+
+            llvm::Value* header = llvm::UndefValue::get(headerTy);
+            header = builder.CreateInsertValue(header, data, 0);
+            header = builder.CreateInsertValue(header, n, 1);
+            header = builder.CreateInsertValue(header, isBits ? builder.CreateShl(count, 6) : n, 2);
+            for(size_t d = 0; rank > 1 && d < rank; d++)
+                header = builder.CreateInsertValue(header, getArrayDim(like, d), {3, static_cast<unsigned>(d)});
+
+            llvm::Value* alloc = createVariableStorage(targetName, headerTy);
+            builder.CreateStore(header, alloc);
+            info = { alloc, inferLiteralTypeFromLLVM(resultTy, unsignedNodes[expr.get()]), true, 0 };
+            info.isDynamic = true;
+        } else {
+            size_t count = isBits ? (like->size + 63) / 64 : like->size;
+            llvm::Value* alloc = createVariableStorage(targetName, llvm::ArrayType::get(storageTy, count)); // aligned ke lebar vector
+            info = { alloc, inferLiteralTypeFromLLVM(resultTy, unsignedNodes[expr.get()]), true, like->size };
+            info.shape = like->shape;
+        }
+        VariablesStack.back()[targetName] = info;
+        target = &VariablesStack.back()[targetName];
+    } else {
+        target = lookupVariable(targetName);
+    }
+    Operand out = addArray(target);
+
+    // semua operand harus punya jumlah elemen (dan shape) sama dengan target
+    llvm::Value* n = getArrayLength(target);
+    for(auto& [name, op] : arrays){
+        if(!op.var->isDynamic && !target->isDynamic){
+            if(op.var->size != target->size || getArrayRank(op.var) != getArrayRank(target) ||
+               (!op.var->shape.empty() && !target->shape.empty() && op.var->shape != target->shape))
+                throw std::runtime_error("Array shape mismatch in elementwise operation: " + name);
+            continue;
+        }
+        genRuntimeError(builder.CreateICmpNE(getArrayLength(op.var), n), "Runtime Error: Array length mismatch in elementwise operation");
+    }
+
+    // semua operand array bool dan operasinya hanya ! == != and or xor: dikerjakan per word i64,
+    // 64 elemen sekaligus tanpa bongkar bit. bit sisa di word terakhir ikut ditulis (tidak dibaca)
+    std::function<bool(const std::shared_ptr<Stmt>&)> wordWise = [&](const std::shared_ptr<Stmt>& e) -> bool {
+        auto hoisted = scalars.find(e.get());
+        if(hoisted != scalars.end()) return hoisted->second->getType()->isIntegerTy(1);
+        std::string op;
+        std::shared_ptr<Stmt> left, right;
+        if(binaryParts(e, op, left, right))
+            return (op == "==" || op == "!=" || op == "&" || op == "|" || op == "^") && wordWise(left) && wordWise(right);
+        if(e->type == StmtType::UnaryOp)
+            return std::static_pointer_cast<UnaryOpStmt>(e)->op == "!" && wordWise(std::static_pointer_cast<UnaryOpStmt>(e)->operand);
+        return e->type == StmtType::Identifier && isBitArray(arrays.at(std::static_pointer_cast<IdentifierStmt>(e)->name).var);
+    };
+    if(isBitArray(target) && wordWise(expr)){
+        llvm::Type* wordTy = builder.getInt64Ty();
+        std::function<llvm::Value*(const std::shared_ptr<Stmt>&, llvm::Value*)> emitWord =
+            [&](const std::shared_ptr<Stmt>& e, llvm::Value* w) -> llvm::Value* {
+                auto hoisted = scalars.find(e.get());
+                if(hoisted != scalars.end()) return builder.CreateSExt(hoisted->second, wordTy); // true -> semua bit 1
+                std::string op;
+                std::shared_ptr<Stmt> left, right;
+                if(binaryParts(e, op, left, right)){
+                    llvm::Value* l = emitWord(left, w);
+                    llvm::Value* r = emitWord(right, w);
+                    if(op == "&") return builder.CreateAnd(l, r);
+                    if(op == "|") return builder.CreateOr(l, r);
+                    if(op == "!=" || op == "^") return builder.CreateXor(l, r);
+                    return builder.CreateNot(builder.CreateXor(l, r)); // ==
+                }
+                if(e->type == StmtType::UnaryOp) return builder.CreateNot(emitWord(std::static_pointer_cast<UnaryOpStmt>(e)->operand, w));
+                const Operand& op2 = arrays.at(std::static_pointer_cast<IdentifierStmt>(e)->name);
+                return builder.CreateLoad(wordTy, builder.CreateInBoundsGEP(wordTy, op2.data, w));
+            };
+        emitCountedLoop(builder.getInt64(0), bitWordCount(n), 1, "ew_words", {}, [&](llvm::Value* w, const std::vector<llvm::Value*>&){
+            builder.CreateStore(emitWord(expr, w), builder.CreateInBoundsGEP(wordTy, out.data, w));
+            return std::vector<llvm::Value*>{};
+        });
+        return;
+    }
+
+    // lane per vector ditentukan elemen terlebar yang ikut dihitung
+    std::vector<llvm::Type*> involved = {resultTy, out.elemTy};
+    for(auto& [name, op] : arrays) involved.push_back(op.elemTy);
+    for(auto& [stmt, val] : scalars) involved.push_back(val->getType());
+    unsigned lanes = vectorLanes(involved);
+
+    auto load = [&](const Operand& op, llvm::Value* idx, unsigned vf){ return loadArrayLanes(op.var, op.data, idx, vf); };
+    auto store = [&](llvm::Value* val, llvm::Value* idx, unsigned vf){
+        llvm::Type* storeTy = vf == 1 ? out.elemTy : llvm::FixedVectorType::get(out.elemTy, vf);
+        storeArrayLanes(out.var, out.data, idx, castToType(val, storeTy, isUnsignedType(out.var->dataType)));
+    };
+
+    // tahap 2: hitung ekspresi untuk elemen ke-idx
+    std::function<llvm::Value*(const std::shared_ptr<Stmt>&, llvm::Value*, unsigned)> emit =
+        [&](const std::shared_ptr<Stmt>& e, llvm::Value* idx, unsigned vf) -> llvm::Value* {
+            auto hoisted = scalars.find(e.get());
+            if(hoisted != scalars.end())
+                return vf == 1 ? hoisted->second : markUnsigned(builder.CreateVectorSplat(vf, hoisted->second), isUnsignedValue(hoisted->second));
+            std::string op;
+            std::shared_ptr<Stmt> left, right;
+            if(binaryParts(e, op, left, right))
+                return emitBinaryOp(op, emit(left, idx, vf), emit(right, idx, vf));
+            if(e->type == StmtType::UnaryOp){
+                auto un = std::static_pointer_cast<UnaryOpStmt>(e);
+                return emitUnaryOp(un->op, emit(un->operand, idx, vf));
+            }
+            return load(arrays.at(std::static_pointer_cast<IdentifierStmt>(e)->name), idx, vf);
+        };
+
+    // loop vector untuk kelipatan lanes, lalu loop skalar untuk sisanya
+    llvm::Value* vecEnd = builder.CreateAnd(n, builder.getInt64(~static_cast<uint64_t>(lanes - 1)), "vecend");
+    if(lanes > 1){
+        emitCountedLoop(builder.getInt64(0), vecEnd, lanes, "ew_vec", {}, [&](llvm::Value* idx, const std::vector<llvm::Value*>&){
+            store(emit(expr, idx, lanes), idx, lanes);
+            return std::vector<llvm::Value*>{};
+        });
+    }
+    emitCountedLoop(lanes > 1 ? vecEnd : builder.getInt64(0), n, 1, "ew_tail", {}, [&](llvm::Value* idx, const std::vector<llvm::Value*>&){
+        store(emit(expr, idx, 1), idx, 1);
+        return std::vector<llvm::Value*>{};
+    });
+}
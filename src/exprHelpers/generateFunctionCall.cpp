@@ -1,19 +1,127 @@
 #include "../../include/CodeGen.hpp"
 
 llvm::Value* CodeGen::generateFunctionCall(const std::shared_ptr<FunctionCallStmt>& callStmt){
-    llvm::Function* calleeFunc = module->getFunction(callStmt->name);
-    if(!calleeFunc) {
+    // function generic: argumen skalar di-generate dulu untuk tahu tipenya (sekali saja, bisa ada efek samping),
+    // lalu dipanggil instance yang cocok dengan tipe argumen
+    std::vector<llvm::Value*> evaluated(callStmt->args.size(), nullptr);
+    std::string calleeName = callStmt->name;
+    auto generic = GenericFunctions.find(callStmt->name);
+    if(generic != GenericFunctions.end()){
+        const auto& genericParams = generic->second.decl->params;
+        if(callStmt->args.size() != genericParams.size())
+            throw std::runtime_error(callStmt->name + " expects " + std::to_string(genericParams.size()) + " argument(s)");
+
+        std::vector<ParamInfo> argTypes;
+        for(size_t i = 0; i < callStmt->args.size(); i++){
+            auto param = std::static_pointer_cast<VarDeclStmt>(genericParams[i]);
+            ParamInfo argType = { param->name, param->varType, param->isArray };
+            argType.structName = param->structName;
+            if(!param->hasExplicit){
+                // array dikirim by reference, selain itu tipe diambil dari nilai argumen
+                auto id = std::dynamic_pointer_cast<IdentifierStmt>(callStmt->args[i]);
+                VarInfo* var = id ? lookupVariable(id->name) : nullptr;
+                if(var && var->isArray){
+                    argType.dataType = var->dataType;
+                    argType.structName = var->structTypeName;
+                    argType.isArray = true;
+                } else {
+                    evaluated[i] = generateExpression(callStmt->args[i]);
+                    argType.structName = structNameOf(evaluated[i]);
+                    argType.dataType = argType.structName.empty() ? valueLiteralType(evaluated[i]) : LiteralType::STRUCT;
+                    if(argType.dataType == LiteralType::UNKNOWN)
+                        throw std::runtime_error(callStmt->name + ": cannot pass this value to untyped parameter " + param->name);
+                }
+            }
+            argTypes.push_back(argType);
+        }
+        calleeName = instantiateGeneric(callStmt->name, argTypes);
+    }
+
+    llvm::Function* calleeFunc = module->getFunction(calleeName);
+    auto found = Functions.find(calleeName);
+    if(!calleeFunc || found == Functions.end()) {
+        // bukan fungsi user, cek apakah builtin (save, load, dll)
+        if(llvm::Value* builtinVal = generateBuiltinCall(callStmt)) return builtinVal;
         throw std::runtime_error("Undefined function: " + callStmt->name);
     }
     
+    const FunctionInfo& info = found->second;
+    const std::vector<ParamInfo>& params = info.params;
+    if(callStmt->args.size() != params.size())
+        throw std::runtime_error(callStmt->name + " expects " + std::to_string(params.size()) + " argument(s)");
+
+    // hasil struct / array: buffer di stack pemanggil, diisi oleh function (sret)
+    // atau oleh nilai return kalau struct cukup kecil untuk register
     std::vector<llvm::Value*> argsV;
-    for(auto& arg : callStmt->args) {
-        argsV.push_back(generateExpression(arg));
+    llvm::Value* retBuf = nullptr;
+    if(info.returnsAggregate()){
+        llvm::Type* bufTy = info.sret ? calleeFunc->getArg(0)->getType()->getPointerElementType() : calleeFunc->getReturnType();
+        retBuf = createVariableStorage(calleeName + "_ret", bufTy);
+        CallResults[retBuf] = calleeName;
+        if(info.sret) argsV.push_back(retBuf);
+    }
+    for(size_t i = 0; i < callStmt->args.size(); i++) {
+        const ParamInfo& param = params[i];
+
+        // parameter array: kirim pointer data + panjang, tanpa salin
+        if(param.isArray){
+            auto id = std::dynamic_pointer_cast<IdentifierStmt>(callStmt->args[i]);
+            VarInfo* var = id ? lookupVariable(id->name) : nullptr;
+            if(!var || !var->isArray)
+                throw std::runtime_error(callStmt->name + ": parameter " + param.name + " expects an array variable");
+            if(var->dataType != param.dataType || var->structTypeName != param.structName)
+                throw std::runtime_error(callStmt->name + ": parameter " + param.name + " expects an array of a different element type");
+            if(getArrayRank(var) != 1)
+                throw std::runtime_error(callStmt->name + ": parameter " + param.name + " expects a one-dimensional array");
+
+            // array yang ditulis function tidak boleh dikirim dua kali (parameter array ditandai noalias)
+            for(size_t j = 0; j < callStmt->args.size(); j++){
+                auto other = std::dynamic_pointer_cast<IdentifierStmt>(callStmt->args[j]);
+                if(j != i && params[j].isArray && other && other->name == id->name && (param.writes || params[j].writes))
+                    throw std::runtime_error(callStmt->name + ": array " + id->name + " is modified by the function and cannot be passed twice");
+            }
+
+            argsV.push_back(getArrayDataPtr(var));
+            argsV.push_back(getArrayLength(var));
+            // @soa: jarak antar kolom ikut dikirim
+            if(isSoaArray(var))
+                argsV.push_back(builder.CreateLoad(builder.getInt64Ty(), builder.CreateStructGEP(var->storageType(), var->alloc, 2), "soa_cap"));
+            continue;
+        }
+
+        // parameter struct: kecil dikirim by value, besar dikirim pointer (function tidak menulis ke situ)
+        if(!param.structName.empty()){
+            std::string structName;
+            llvm::Value* ptr = evaluated[i];
+            if(ptr) structName = structNameOf(ptr);
+            else ptr = structPointer(callStmt->args[i], structName);
+            if(structName != param.structName)
+                throw std::runtime_error(callStmt->name + ": parameter " + param.name + " expects a " + param.structName);
+            llvm::StructType* structTy = StructTypes.at(structName).type;
+            argsV.push_back(calleeFunc->getArg(argsV.size())->getType()->isPointerTy() ? ptr : builder.CreateLoad(structTy, ptr));
+            continue;
+        }
+
+        llvm::Value* val = evaluated[i] ? evaluated[i] : generateExpression(callStmt->args[i]);
+        // argumen angka dikonversi ke tipe parameter (misal literal 5 ke parameter u8)
+        llvm::Type* paramTy = calleeFunc->getArg(argsV.size())->getType();
+        bool numeric = (val->getType()->isIntegerTy() || val->getType()->isFloatingPointTy()) &&
+                       (paramTy->isIntegerTy() || paramTy->isFloatingPointTy());
+        if(numeric && val->getType() != paramTy) val = castToType(val, paramTy, isUnsignedType(param.dataType));
+        argsV.push_back(val);
     }
     
-    if(calleeFunc->getReturnType()->isVoidTy()) {
-        return builder.CreateCall(calleeFunc, argsV); 
-    } else {
-        return builder.CreateCall(calleeFunc, argsV, "calltmp");
+    // function user memakai fastcc, call site harus sama
+    if(retBuf) {
+        llvm::CallInst* call = builder.CreateCall(calleeFunc, argsV);
+        call->setCallingConv(calleeFunc->getCallingConv());
+        if(info.sret) call->addParamAttr(0, llvm::Attribute::getWithStructRetType(context, retBuf->getType()->getPointerElementType()));
+        else builder.CreateStore(call, retBuf);
+        return retBuf; // sama seperti variabel struct: pointer ke data
     }
+    llvm::CallInst* call = calleeFunc->getReturnType()->isVoidTy() ? builder.CreateCall(calleeFunc, argsV)
+                                                                    : builder.CreateCall(calleeFunc, argsV, "calltmp");
+    call->setCallingConv(calleeFunc->getCallingConv());
+    if(call->getType()->isVoidTy()) return call;
+    return markUnsigned(call, isUnsignedType(info.returnType));
 }
\ No newline at end of file
@@ -15,14 +15,24 @@ llvm::Value* CodeGen::generateIdentifier(const std::shared_ptr<IdentifierStmt>&
             return builder.CreateLoad(builder.getInt32Ty(), var->alloc, identifierStmt->name);
         case LiteralType::INT_64:
             return builder.CreateLoad(builder.getInt64Ty(), var->alloc, identifierStmt->name);
-        // case LiteralType::FLOAT:
-        //     return builder.CreateLoad(builder.getDoubleTy(), var->alloc, identifierStmt->name);    
+        case LiteralType::FLOAT:
+            return builder.CreateLoad(builder.getFloatTy(), var->alloc, identifierStmt->name);
         case LiteralType::DOUBLE:
             return builder.CreateLoad(builder.getDoubleTy(), var->alloc, identifierStmt->name);
         case LiteralType::BOOL:
             return builder.CreateLoad(builder.getInt1Ty(), var->alloc, identifierStmt->name);
         case LiteralType::STRING:
-            return builder.CreateLoad(builder.getInt8PtrTy(), var->alloc, identifierStmt->name);
+            return builder.CreateLoad(strType, var->alloc, identifierStmt->name);
+        case LiteralType::INT_8:
+        case LiteralType::INT_16:
+            return builder.CreateLoad(literalTypeToLLVM(var->dataType), var->alloc, identifierStmt->name);
+        case LiteralType::UINT_8:
+        case LiteralType::UINT_16:
+        case LiteralType::UINT_32:
+        case LiteralType::UINT_64:
+            return markUnsigned(builder.CreateLoad(literalTypeToLLVM(var->dataType), var->alloc, identifierStmt->name));
+        default:
+            break;
     }
     return nullptr;
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ llvm::Value* CodeGen::generateInput(const std::shared_ptr<InputStmt>& inputStmt)
     }
 
     // alokasi buffer untuk input string
-    llvm::AllocaInst *buffer = createEntryBlockAlloca(mainFun, "input_buffer", builder.getInt8Ty(), 256);
+    llvm::AllocaInst *buffer = createEntryBlockAlloca(builder.GetInsertBlock()->getParent(), "input_buffer", builder.getInt8Ty(), 256);
     // panggil runtime function untuk input (misal getchar atau scanf)
     llvm::FunctionType* funcType = llvm::FunctionType::get(
         builder.getVoidTy(),
@@ -27,37 +27,33 @@ llvm::Value* CodeGen::generateInput(const std::shared_ptr<InputStmt>& inputStmt)
     builder.CreateCall(inputFunc, {buffer}); // buffer jadi tempat menyimpan input
     
     // konversi sesuai tipe
-    if(inputStmt->dataType == "i32") {
-        llvm::Function* atoiFunc = module->getFunction("atoi");
-        if(!atoiFunc){
-            llvm::FunctionType* atoiType = llvm::FunctionType::get(builder.getInt32Ty(), {builder.getInt8PtrTy()}, false);
-            atoiFunc = llvm::Function::Create(atoiType, llvm::Function::ExternalLinkage, "atoi", module.get());
-        }
+    // atoi -> i32, atoll -> i64 (i8 / i16 dipotong), strtoull -> u8..u64, atof selalu double (f32 dibulatkan setelahnya)
+    const std::string& ty = inputStmt->dataType;
+    if(ty == "i32") {
+        llvm::FunctionCallee atoiFunc = module->getOrInsertFunction("atoi",
+            llvm::FunctionType::get(builder.getInt32Ty(), {builder.getInt8PtrTy()}, false));
         return builder.CreateCall(atoiFunc, {buffer}); // i32
     }
-    else if(inputStmt->dataType == "i64") {
-        llvm::Function* atoiFunc = module->getFunction("atoi");
-        if(!atoiFunc){
-            llvm::FunctionType* atoiType = llvm::FunctionType::get(builder.getInt64Ty(), {builder.getInt8PtrTy()}, false);
-            atoiFunc = llvm::Function::Create(atoiType, llvm::Function::ExternalLinkage, "atoi", module.get());
-        }
-        return builder.CreateCall(atoiFunc, {buffer}); // i32
+    else if(ty == "i64" || ty == "i8" || ty == "i16") {
+        llvm::FunctionCallee atollFunc = module->getOrInsertFunction("atoll",
+            llvm::FunctionType::get(builder.getInt64Ty(), {builder.getInt8PtrTy()}, false));
+        llvm::Value* val = builder.CreateCall(atollFunc, {buffer}); // i64
+        return builder.CreateTrunc(val, builder.getIntNTy(std::stoi(ty.substr(1))));
     }
-    else if(inputStmt->dataType == "float") {
-        llvm::Function* atofFunc = module->getFunction("atof");
-        if(!atofFunc){
-            llvm::FunctionType* atofType = llvm::FunctionType::get(builder.getFloatTy(), {builder.getInt8PtrTy()}, false);
-            atofFunc = llvm::Function::Create(atofType, llvm::Function::ExternalLinkage, "atof", module.get());
-        }
-        return builder.CreateCall(atofFunc, {buffer}); // double
+    else if(ty == "u8" || ty == "u16" || ty == "u32" || ty == "u64") {
+        llvm::FunctionCallee strtoullFunc = module->getOrInsertFunction("strtoull",
+            llvm::FunctionType::get(builder.getInt64Ty(), {builder.getInt8PtrTy(), builder.getInt8PtrTy()->getPointerTo(), builder.getInt32Ty()}, false));
+        llvm::Value* val = builder.CreateCall(strtoullFunc, {buffer, llvm::ConstantPointerNull::get(builder.getInt8PtrTy()->getPointerTo()), builder.getInt32(10)});
+        return markUnsigned(builder.CreateTrunc(val, builder.getIntNTy(std::stoi(ty.substr(1)))));
     }
-    else if(inputStmt->dataType == "double") {
-        llvm::Function* atofFunc = module->getFunction("atof");
-        if(!atofFunc){
-            llvm::FunctionType* atofType = llvm::FunctionType::get(builder.getDoubleTy(), {builder.getInt8PtrTy()}, false);
-            atofFunc = llvm::Function::Create(atofType, llvm::Function::ExternalLinkage, "atof", module.get());
-        }
-        return builder.CreateCall(atofFunc, {buffer}); // double
+    else if(inputStmt->dataType == "float" || inputStmt->dataType == "f32" ||
+            inputStmt->dataType == "double" || inputStmt->dataType == "f64") {
+        llvm::FunctionCallee atofFunc = module->getOrInsertFunction("atof",
+            llvm::FunctionType::get(builder.getDoubleTy(), {builder.getInt8PtrTy()}, false));
+        llvm::Value* val = builder.CreateCall(atofFunc, {buffer}); // double
+        if(inputStmt->dataType == "float" || inputStmt->dataType == "f32")
+            return builder.CreateFPTrunc(val, builder.getFloatTy()); // f32
+        return val;
     }
     else if(inputStmt->dataType == "bool") {
         llvm::Function* strcmpFunc = module->getFunction("strcmp");
@@ -65,10 +61,18 @@ llvm::Value* CodeGen::generateInput(const std::shared_ptr<InputStmt>& inputStmt)
             llvm::FunctionType* strcmpType = llvm::FunctionType::get(builder.getInt32Ty(), {builder.getInt8PtrTy(), builder.getInt8PtrTy()}, false);
             strcmpFunc = llvm::Function::Create(strcmpType, llvm::Function::ExternalLinkage, "strcmp", module.get());
         }
-        llvm::Value* cmp = builder.CreateCall(strcmpFunc, {buffer, builder.CreateGlobalStringPtr("0")});
+        llvm::Value* cmp = builder.CreateCall(strcmpFunc, {buffer, getCString("0")});
         return builder.CreateICmpNE(cmp, builder.getInt32(0)); // i1
     }
     else { // string
-        return buffer; // i8*
+        // panjang dihitung sekali di sini, setelah itu tidak perlu strlen lagi
+        llvm::FunctionCallee strlenFunc = module->getOrInsertFunction("strlen",
+            llvm::FunctionType::get(builder.getInt64Ty(), {builder.getInt8PtrTy()}, false));
+        llvm::Value* len = builder.CreateCall(strlenFunc, {buffer}, "inputlen");
+        // buffer dipakai ulang tiap input, hasilnya disalin ke arena supaya str tetap valid
+        llvm::FunctionCallee dupFunc = module->getOrInsertFunction("aiko_arena_strdup",
+            llvm::FunctionType::get(builder.getInt8PtrTy(), {builder.getInt8PtrTy(), builder.getInt64Ty()}, false));
+        llvm::Value* text = builder.CreateCall(dupFunc, {buffer, len}, "inputstr");
+        return makeString(text, len); // { i8*, i64 }
     }
 }
\ No newline at end of file
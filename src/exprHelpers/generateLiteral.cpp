@@ -10,17 +10,11 @@ llvm::Value* CodeGen::generateLiteral(const std::shared_ptr<LiteralStmt>& litera
             int64_t val = std::get<int64_t>(literalStmt->value);
             return llvm::ConstantInt::get(builder.getInt64Ty(), val, true);
         }
-        // case LiteralType::FLOAT: {
-    
-        //     double val = std::get<double>(literalStmt->value);
-        //     return llvm::ConstantFP::get(builder.getFloat(), val);
-        //     if (auto ptr = std::get_if<double>(&literalStmt->value)) {
-        //         double val = *ptr;
-        //         return llvm::ConstantFP::get(builder.getDoubleTy(), val);
-        //     } else {
-        //         throw std::runtime_error("LiteralType DOUBLE tapi variant bukan double");
-        //     }
-        // }
+        case LiteralType::FLOAT: {
+            // disimpan sebagai double di AST, nilainya sudah dibulatkan ke float oleh parser
+            double val = std::get<double>(literalStmt->value);
+            return llvm::ConstantFP::get(builder.getFloatTy(), val);
+        }
         case LiteralType::DOUBLE: {
             double val = std::get<double>(literalStmt->value);
             return llvm::ConstantFP::get(builder.getDoubleTy(), val);
@@ -37,7 +31,7 @@ llvm::Value* CodeGen::generateLiteral(const std::shared_ptr<LiteralStmt>& litera
         }
         case LiteralType::STRING: {
             std::string val = std::get<std::string>(literalStmt->value);
-            return builder.CreateGlobalStringPtr(val);
+            return getStringLiteral(val);
         }
         case LiteralType::UNKNOWN: {
             throw std::runtime_error("Data type  is unknown\n");
@@ -0,0 +1,61 @@
+#include "../../include/CodeGen.hpp"
+
+// operand kanan yang aman dan murah dihitung walaupun hasilnya tidak dipakai:
+// tanpa call, input, akses index (bounds check) dan bagi / modulo (bagi nol)
+static bool isCheapOperand(const std::shared_ptr<Stmt>& expr){
+    switch(expr->type){
+        case StmtType::Literal:
+        case StmtType::Identifier:
+            return true;
+        case StmtType::BinaryOp: {
+            const std::string& op = std::static_pointer_cast<BinaryOpStmt>(expr)->op;
+            if(op == "/" || op == "%") return false;
+            [[fallthrough]];
+        }
+        case StmtType::UnaryOp:
+        case StmtType::MemberAccess: {
+            bool cheap = true;
+            forEachChild(expr, [&](const std::shared_ptr<Stmt>& child){ cheap = cheap && isCheapOperand(child); });
+            return cheap;
+        }
+        default:
+            return false;
+    }
+}
+
+// a && b / a || b: b hanya dihitung kalau a belum menentukan hasil (branch + phi).
+// b yang murah dan tanpa efek samping langsung dihitung lalu dipilih dengan select, tanpa branch
+llvm::Value* CodeGen::generateLogical(const std::shared_ptr<BinaryOpStmt>& binOp){
+    bool isAnd = binOp->op == "&&";
+    llvm::Value* left = generateExpression(binOp->left);
+    if(!left->getType()->isIntegerTy(1))
+        throw std::runtime_error("Operator " + binOp->op + " needs bool operands");
+
+    if(isCheapOperand(binOp->right)){
+        llvm::Value* right = generateExpression(binOp->right);
+        if(!right->getType()->isIntegerTy(1))
+            throw std::runtime_error("Operator " + binOp->op + " needs bool operands");
+        return isAnd ? builder.CreateSelect(left, right, builder.getFalse(), "andtmp")
+                     : builder.CreateSelect(left, builder.getTrue(), right, "ortmp");
+    }
+
+    llvm::Function* parentFunc = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* leftBB = builder.GetInsertBlock();
+    llvm::BasicBlock* rightBB = llvm::BasicBlock::Create(context, isAnd ? "and_rhs" : "or_rhs", parentFunc);
+    llvm::BasicBlock* doneBB = llvm::BasicBlock::Create(context, isAnd ? "and_done" : "or_done", parentFunc);
+    if(isAnd) builder.CreateCondBr(left, rightBB, doneBB);
+    else builder.CreateCondBr(left, doneBB, rightBB);
+
+    builder.SetInsertPoint(rightBB);
+    llvm::Value* right = generateExpression(binOp->right);
+    if(!right->getType()->isIntegerTy(1))
+        throw std::runtime_error("Operator " + binOp->op + " needs bool operands");
+    llvm::BasicBlock* rightEndBB = builder.GetInsertBlock(); // b bisa membuat block sendiri (bounds check, string)
+    builder.CreateBr(doneBB);
+
+    builder.SetInsertPoint(doneBB);
+    llvm::PHINode* phi = builder.CreatePHI(builder.getInt1Ty(), 2, isAnd ? "and" : "or");
+    phi->addIncoming(isAnd ? builder.getFalse() : builder.getTrue(), leftBB);
+    phi->addIncoming(right, rightEndBB);
+    return phi;
+}
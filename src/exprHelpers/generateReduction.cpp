@@ -0,0 +1,178 @@
+#include "../../include/CodeGen.hpp"
+
+// reduksi array: sum, min, max, dot, argmin, argmax (+ sum_fast / dot_fast)
+// loop vector dengan beberapa akumulator sekaligus (supaya tidak menunggu latency add),
+// lalu digabung horizontal dengan llvm.vector.reduce.* dan sisa elemen pakai loop skalar.
+// sum / dot float biasa tetap dijumlah berurutan (hasil sama persis dengan loop biasa),
+// versi _fast boleh mengubah urutan penjumlahan (reassoc) supaya bisa di-vector.
+
+static const unsigned REDUCE_ACCUMULATORS = 4;
+
+llvm::Value* CodeGen::generateReduction(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    const std::string& name = callStmt->name;
+    bool isDot = name == "dot" || name == "dot_fast";
+    bool fast = name == "sum_fast" || name == "dot_fast";
+    size_t argCount = isDot ? 2 : 1;
+    if(callStmt->args.size() != argCount)
+        throw std::runtime_error(name + " expects " + std::to_string(argCount) + " array argument(s)");
+
+    std::vector<VarInfo*> vars;
+    std::vector<llvm::Value*> datas;
+    for(const auto& arg : callStmt->args){
+        auto id = std::dynamic_pointer_cast<IdentifierStmt>(arg);
+        VarInfo* var = id ? lookupVariable(id->name) : nullptr;
+        if(!var || !var->isArray) throw std::runtime_error(name + " expects array variables");
+        llvm::Type* elemTy = getArrayElementType(var);
+        if(!elemTy->isIntegerTy() && !elemTy->isFloatingPointTy())
+            throw std::runtime_error(name + " needs a numeric array");
+        vars.push_back(var);
+        datas.push_back(getArrayDataPtr(var));
+    }
+
+    // jumlah elemen true array bool = popcount per word
+    if((name == "sum" || name == "sum_fast") && isBitArray(vars[0])) return emitBitReduce(vars[0], "count");
+
+    llvm::Value* n = getArrayLength(vars[0]);
+    if(isDot){
+        if(!vars[0]->isDynamic && !vars[1]->isDynamic){
+            if(vars[0]->size != vars[1]->size) throw std::runtime_error("dot: arrays must have the same length");
+        } else {
+            genRuntimeError(builder.CreateICmpNE(n, getArrayLength(vars[1])), "Runtime Error: dot: arrays must have the same length");
+        }
+    }
+
+    // bool dijumlah sebagai jumlah elemen true, sum / dot i8..u16 dijumlah di i64 supaya tidak overflow
+    bool isMinMax = !isDot && name != "sum" && name != "sum_fast";
+    llvm::Type* resultTy = getArrayElementType(vars[0]);
+    if(isDot) resultTy = promoteBinaryType(resultTy, getArrayElementType(vars[1]));
+    if(resultTy->isIntegerTy(1) || (!isMinMax && resultTy->isIntegerTy() && resultTy->getIntegerBitWidth() < 32))
+        resultTy = builder.getInt64Ty();
+    bool isFloat = resultTy->isFloatingPointTy();
+    bool isUnsigned = !isFloat;
+    for(VarInfo* v : vars)
+        isUnsigned = isUnsigned && isUnsignedType(v->dataType) && getArrayElementType(v)->getIntegerBitWidth() == resultTy->getIntegerBitWidth();
+
+    std::vector<llvm::Type*> involved = {resultTy};
+    for(VarInfo* v : vars) involved.push_back(getArrayElementType(v));
+    unsigned lanes = vectorLanes(involved);
+    llvm::Type* vecTy = llvm::FixedVectorType::get(resultTy, lanes);
+
+    // nilai elemen ke-idx (vf lane), sudah dikonversi ke tipe hasil; dot = a[i] * b[i]
+    auto element = [&](llvm::Value* idx, unsigned vf) -> llvm::Value* {
+        llvm::Type* ty = vf == 1 ? resultTy : static_cast<llvm::Type*>(llvm::FixedVectorType::get(resultTy, vf));
+        llvm::Value* v = castToType(loadArrayLanes(vars[0], datas[0], idx, vf), ty);
+        if(isDot) v = emitBinaryOp("*", v, castToType(loadArrayLanes(vars[1], datas[1], idx, vf), ty));
+        return v;
+    };
+
+    // ---- sum / dot ----
+    if(name == "sum" || name == "sum_fast" || isDot){
+        llvm::Value* zero = llvm::Constant::getNullValue(resultTy);
+
+        // float tanpa _fast: urutan penjumlahan dipertahankan
+        if(isFloat && !fast){
+            auto acc = emitCountedLoop(builder.getInt64(0), n, 1, "sum", {zero},
+                [&](llvm::Value* idx, const std::vector<llvm::Value*>& c){
+                    return std::vector<llvm::Value*>{ builder.CreateFAdd(c[0], element(idx, 1)) };
+                });
+            return acc[0];
+        }
+
+        llvm::FastMathFlags reassoc;
+        reassoc.setAllowReassoc();
+        llvm::IRBuilderBase::FastMathFlagGuard guard(builder);
+        if(isFloat) builder.setFastMathFlags(reassoc);
+
+        uint64_t block = uint64_t(lanes) * REDUCE_ACCUMULATORS;
+        llvm::Value* vecEnd = builder.CreateAnd(n, builder.getInt64(~(block - 1)), "vecend");
+        std::vector<llvm::Value*> init(REDUCE_ACCUMULATORS, llvm::Constant::getNullValue(vecTy));
+        auto accs = emitCountedLoop(builder.getInt64(0), vecEnd, block, "sum_vec", init,
+            [&](llvm::Value* idx, const std::vector<llvm::Value*>& c){
+                std::vector<llvm::Value*> next;
+                for(unsigned k = 0; k < REDUCE_ACCUMULATORS; k++){
+                    llvm::Value* at = builder.CreateAdd(idx, builder.getInt64(k * lanes));
+                    llvm::Value* v = element(at, lanes);
+                    next.push_back(isFloat ? builder.CreateFAdd(c[k], v) : builder.CreateAdd(c[k], v));
+                }
+                return next;
+            });
+
+        llvm::Value* total = accs[0];
+        for(unsigned k = 1; k < REDUCE_ACCUMULATORS; k++)
+            total = isFloat ? builder.CreateFAdd(total, accs[k]) : builder.CreateAdd(total, accs[k]);
+        llvm::Value* scalar = isFloat ? builder.CreateFAddReduce(zero, total) : builder.CreateAddReduce(total);
+
+        auto acc = emitCountedLoop(vecEnd, n, 1, "sum_tail", {scalar},
+            [&](llvm::Value* idx, const std::vector<llvm::Value*>& c){
+                llvm::Value* v = element(idx, 1);
+                return std::vector<llvm::Value*>{ isFloat ? builder.CreateFAdd(c[0], v) : builder.CreateAdd(c[0], v) };
+            });
+        return markUnsigned(acc[0], isUnsigned);
+    }
+
+    // min / max / argmin / argmax butuh minimal 1 elemen
+    genRuntimeError(builder.CreateICmpEQ(n, builder.getInt64(0)), "Runtime Error: " + name + " of empty array");
+    bool wantMin = name == "min" || name == "argmin";
+    bool wantIndex = name == "argmin" || name == "argmax";
+    bool isSigned = !getArrayElementType(vars[0])->isIntegerTy(1) && !isUnsignedType(vars[0]->dataType);
+
+    // true kalau x lebih baik dari best (strict, jadi index pertama yang menang)
+    auto better = [&](llvm::Value* x, llvm::Value* best){
+        if(isFloat) return wantMin ? builder.CreateFCmpOLT(x, best) : builder.CreateFCmpOGT(x, best);
+        if(isSigned) return wantMin ? builder.CreateICmpSLT(x, best) : builder.CreateICmpSGT(x, best);
+        return wantMin ? builder.CreateICmpULT(x, best) : builder.CreateICmpUGT(x, best);
+    };
+    auto horizontal = [&](llvm::Value* vec){
+        if(isFloat) return wantMin ? builder.CreateFPMinReduce(vec) : builder.CreateFPMaxReduce(vec);
+        return wantMin ? builder.CreateIntMinReduce(vec, isSigned) : builder.CreateIntMaxReduce(vec, isSigned);
+    };
+
+    llvm::Value* first = element(builder.getInt64(0), 1);
+    llvm::Value* vecEnd = builder.CreateAnd(n, builder.getInt64(~uint64_t(lanes - 1)), "vecend");
+
+    // ---- min / max: akumulator vector, mulai dari elemen pertama ----
+    if(!wantIndex){
+        auto best = emitCountedLoop(builder.getInt64(0), vecEnd, lanes, "minmax_vec", {builder.CreateVectorSplat(lanes, first)},
+            [&](llvm::Value* idx, const std::vector<llvm::Value*>& c){
+                llvm::Value* v = element(idx, lanes);
+                return std::vector<llvm::Value*>{ builder.CreateSelect(better(v, c[0]), v, c[0]) };
+            });
+        auto result = emitCountedLoop(vecEnd, n, 1, "minmax_tail", {horizontal(best[0])},
+            [&](llvm::Value* idx, const std::vector<llvm::Value*>& c){
+                llvm::Value* v = element(idx, 1);
+                return std::vector<llvm::Value*>{ builder.CreateSelect(better(v, c[0]), v, c[0]) };
+            });
+        return markUnsigned(result[0], isUnsignedType(vars[0]->dataType));
+    }
+
+    // ---- argmin / argmax: tiap lane simpan nilai terbaik + index-nya ----
+    llvm::Type* idxVecTy = llvm::FixedVectorType::get(builder.getInt64Ty(), lanes);
+    std::vector<llvm::Constant*> laneIds;
+    for(unsigned k = 0; k < lanes; k++) laneIds.push_back(builder.getInt64(k));
+    llvm::Value* laneOffsets = llvm::ConstantVector::get(laneIds);
+
+    auto best = emitCountedLoop(builder.getInt64(0), vecEnd, lanes, "arg_vec",
+        {builder.CreateVectorSplat(lanes, first), llvm::Constant::getNullValue(idxVecTy)},
+        [&](llvm::Value* idx, const std::vector<llvm::Value*>& c){
+            llvm::Value* v = element(idx, lanes);
+            llvm::Value* ids = builder.CreateAdd(builder.CreateVectorSplat(lanes, idx), laneOffsets);
+            llvm::Value* take = better(v, c[0]);
+            return std::vector<llvm::Value*>{ builder.CreateSelect(take, v, c[0]), builder.CreateSelect(take, ids, c[1]) };
+        });
+
+    // nilai terbaik antar lane, lalu index terkecil di antara lane dengan nilai itu
+    llvm::Value* bestVal = horizontal(best[0]);
+    llvm::Value* isBest = isFloat ? builder.CreateFCmpOEQ(best[0], builder.CreateVectorSplat(lanes, bestVal))
+                                  : builder.CreateICmpEQ(best[0], builder.CreateVectorSplat(lanes, bestVal));
+    llvm::Value* candidates = builder.CreateSelect(isBest, best[1], builder.CreateVectorSplat(lanes, builder.getInt64(INT64_MAX)));
+    llvm::Value* bestIdx = builder.CreateIntMinReduce(candidates, false);
+    // kalau loop vector tidak jalan (n < lanes), semua lane = elemen 0 / index 0, tetap benar
+
+    auto result = emitCountedLoop(vecEnd, n, 1, "arg_tail", {bestVal, bestIdx},
+        [&](llvm::Value* idx, const std::vector<llvm::Value*>& c){
+            llvm::Value* v = element(idx, 1);
+            llvm::Value* take = better(v, c[0]);
+            return std::vector<llvm::Value*>{ builder.CreateSelect(take, v, c[0]), builder.CreateSelect(take, idx, c[1]) };
+        });
+    return result[1];
+}
@@ -0,0 +1,75 @@
+#include "../../include/CodeGen.hpp"
+
+// save(x, "file") / load(x, "file")
+// x bisa array atau struct, ditulis apa adanya sesuai layout llvm (tanpa format teks)
+// hasilnya i64 jumlah elemen yang ditulis / dibaca, -1 kalau gagal
+llvm::Value* CodeGen::generateSaveLoad(const std::shared_ptr<FunctionCallStmt>& callStmt, bool save){
+    const std::string& name = callStmt->name;
+    if(callStmt->args.size() != 2)
+        throw std::runtime_error(name + " expects 2 arguments: (variable, path)");
+
+    auto target = std::dynamic_pointer_cast<IdentifierStmt>(callStmt->args[0]);
+    if(!target) throw std::runtime_error(name + ": first argument must be an array or struct variable");
+
+    VarInfo* var = lookupVariable(target->name);
+    if(!var) throw std::runtime_error("Variable not found: " + target->name);
+
+    // tentukan tipe elemen, alamat data, dan jumlah elemen
+    llvm::Type* elemTy = nullptr;
+    llvm::Value* dataPtr = nullptr;
+    llvm::Value* count = nullptr;
+    LiteralType tag = var->dataType;
+
+    if(isBitArray(var)){
+        // array bool ditulis per word i64
+        elemTy = builder.getInt64Ty();
+        dataPtr = getArrayDataPtr(var);
+        count = bitWordCount(getArrayLength(var));
+    }
+    else if(var->isArray){
+        if(isSoaArray(var)) throw std::runtime_error(name + ": " + target->name + " is stored per field (@soa), save its fields instead");
+        elemTy = getArrayElementType(var);
+        dataPtr = getArrayDataPtr(var);
+        count = getArrayLength(var);
+    }
+    else if(!var->structTypeName.empty()){
+        elemTy = var->storageType();
+        dataPtr = var->alloc;
+        count = builder.getInt64(1);
+        tag = LiteralType::STRUCT;
+    }
+    else {
+        throw std::runtime_error(name + ": " + target->name + " is not an array or struct");
+    }
+
+    // pointer tidak ada artinya di file lain
+    std::function<bool(llvm::Type*)> hasPointer = [&](llvm::Type* ty){
+        if(ty->isPointerTy()) return true;
+        if(auto st = llvm::dyn_cast<llvm::StructType>(ty)){
+            for(llvm::Type* fieldTy : st->elements())
+                if(hasPointer(fieldTy)) return true;
+        }
+        return false;
+    };
+    if(hasPointer(elemTy))
+        throw std::runtime_error(name + ": cannot store str data of " + target->name + " as raw bytes");
+
+    llvm::Value* path = generateExpression(callStmt->args[1]);
+    if(path->getType() != strType)
+        throw std::runtime_error(name + ": path must be a string");
+    llvm::Value* pathPtr = builder.CreateExtractValue(path, 0, "pathptr");
+    llvm::Value* pathLen = builder.CreateExtractValue(path, 1, "pathlen");
+
+    // sizeof dihitung llvm sesuai target, jadi sama persis dengan layout di memori
+    llvm::Value* elemSize = llvm::ConstantExpr::getSizeOf(elemTy);
+    llvm::Value* typeTag = builder.getInt32(static_cast<int32_t>(tag));
+    llvm::Value* rawPtr = builder.CreateBitCast(dataPtr, builder.getInt8PtrTy());
+
+    llvm::FunctionType* funcType = llvm::FunctionType::get(
+        builder.getInt64Ty(),
+        {builder.getInt8PtrTy(), builder.getInt64Ty(), builder.getInt8PtrTy(), builder.getInt64Ty(), builder.getInt64Ty(), builder.getInt32Ty()},
+        false
+    );
+    llvm::FunctionCallee func = module->getOrInsertFunction(save ? "aiko_save" : "aiko_load", funcType);
+    return builder.CreateCall(func, {pathPtr, pathLen, rawPtr, elemSize, count, typeTag}, save ? "savetmp" : "loadtmp");
+}
@@ -0,0 +1,106 @@
+#include "../../include/CodeGen.hpp"
+
+// builtin untuk str: slice, substr, find, count, split, starts_with, ends_with
+// slice/substr/split tidak alokasi, hasilnya view {ptr, len} ke buffer asal
+llvm::Value* CodeGen::generateStringBuiltin(const std::shared_ptr<FunctionCallStmt>& callStmt){
+    const std::string& name = callStmt->name;
+    auto& args = callStmt->args;
+
+    auto expectArgs = [&](size_t n, const std::string& usage){
+        if(args.size() != n) throw std::runtime_error(name + " expects " + usage);
+    };
+    auto genStr = [&](size_t i){
+        llvm::Value* val = generateExpression(args[i]);
+        if(val->getType() != strType) throw std::runtime_error(name + ": argument " + std::to_string(i + 1) + " must be a str");
+        return val;
+    };
+    auto genIndex = [&](size_t i){
+        llvm::Value* val = generateExpression(args[i]);
+        if(!val->getType()->isIntegerTy() || val->getType()->isIntegerTy(1))
+            throw std::runtime_error(name + ": argument " + std::to_string(i + 1) + " must be an integer");
+        return builder.CreateSExtOrTrunc(val, builder.getInt64Ty());
+    };
+    auto clamp = [&](llvm::Value* v, llvm::Value* lo, llvm::Value* hi){
+        v = builder.CreateSelect(builder.CreateICmpSLT(v, lo), lo, v);
+        return builder.CreateSelect(builder.CreateICmpSGT(v, hi), hi, v);
+    };
+    auto runtimeFunc = [&](const std::string& fname, std::vector<llvm::Type*> params){
+        return module->getOrInsertFunction(fname, llvm::FunctionType::get(builder.getInt64Ty(), params, false));
+    };
+
+    llvm::Type* i8p = builder.getInt8PtrTy();
+    llvm::Type* i64 = builder.getInt64Ty();
+
+    if(name == "slice" || name == "substr"){
+        expectArgs(3, name == "slice" ? "(str, start, end)" : "(str, start, count)");
+        llvm::Value* str = genStr(0);
+        llvm::Value* ptr = builder.CreateExtractValue(str, 0);
+        llvm::Value* len = builder.CreateExtractValue(str, 1);
+
+        // index di luar batas di-clamp, bukan error
+        llvm::Value* start = clamp(genIndex(1), builder.getInt64(0), len);
+        llvm::Value* end = genIndex(2);
+        if(name == "substr") end = builder.CreateAdd(start, end);
+        end = clamp(end, start, len);
+
+        llvm::Value* viewPtr = builder.CreateInBoundsGEP(builder.getInt8Ty(), ptr, start, "sliceptr");
+        return makeString(viewPtr, builder.CreateSub(end, start, "slicelen"));
+    }
+
+    if(name == "find" || name == "count"){
+        expectArgs(2, "(str, needle)");
+        llvm::Value* hay = genStr(0);
+        llvm::Value* needle = genStr(1);
+        auto func = runtimeFunc(name == "find" ? "aiko_str_find" : "aiko_str_count", {i8p, i64, i8p, i64});
+        return builder.CreateCall(func, {
+            builder.CreateExtractValue(hay, 0), builder.CreateExtractValue(hay, 1),
+            builder.CreateExtractValue(needle, 0), builder.CreateExtractValue(needle, 1)
+        }, name + "tmp");
+    }
+
+    if(name == "split"){
+        // split(str, sep, n): bagian ke-n, str kosong kalau tidak ada
+        expectArgs(3, "(str, sep, index)");
+        llvm::Value* hay = genStr(0);
+        llvm::Value* sep = genStr(1);
+        llvm::Value* n = genIndex(2);
+        llvm::Value* hayPtr = builder.CreateExtractValue(hay, 0);
+
+        llvm::AllocaInst* partLen = createEntryBlockAlloca(builder.GetInsertBlock()->getParent(), "split_len", i64);
+        auto func = runtimeFunc("aiko_str_split_nth", {i8p, i64, i8p, i64, i64, i64->getPointerTo()});
+        llvm::Value* begin = builder.CreateCall(func, {
+            hayPtr, builder.CreateExtractValue(hay, 1),
+            builder.CreateExtractValue(sep, 0), builder.CreateExtractValue(sep, 1),
+            n, partLen
+        }, "splitpos");
+
+        begin = builder.CreateSelect(builder.CreateICmpSLT(begin, builder.getInt64(0)), builder.getInt64(0), begin);
+        llvm::Value* partPtr = builder.CreateInBoundsGEP(builder.getInt8Ty(), hayPtr, begin, "splitptr");
+        return makeString(partPtr, builder.CreateLoad(i64, partLen));
+    }
+
+    if(name == "starts_with" || name == "ends_with"){
+        expectArgs(2, "(str, affix)");
+        llvm::Value* str = genStr(0);
+        llvm::Value* affix = genStr(1);
+        llvm::Value* ptr = builder.CreateExtractValue(str, 0);
+        llvm::Value* len = builder.CreateExtractValue(str, 1);
+        llvm::Value* affixPtr = builder.CreateExtractValue(affix, 0);
+        llvm::Value* affixLen = builder.CreateExtractValue(affix, 1);
+
+        // tanpa branch: kalau affix lebih panjang, memcmp dipanggil dengan panjang 0
+        llvm::Value* fits = builder.CreateICmpULE(affixLen, len, "fits");
+        llvm::Value* cmpLen = builder.CreateSelect(fits, affixLen, builder.getInt64(0));
+        llvm::Value* offset = builder.getInt64(0);
+        if(name == "ends_with") offset = builder.CreateSelect(fits, builder.CreateSub(len, affixLen), builder.getInt64(0));
+
+        auto memcmpFunc = module->getOrInsertFunction("memcmp",
+            llvm::FunctionType::get(builder.getInt32Ty(), {i8p, i8p, i64}, false));
+        llvm::Value* cmp = builder.CreateCall(memcmpFunc, {
+            builder.CreateInBoundsGEP(builder.getInt8Ty(), ptr, offset), affixPtr, cmpLen
+        }, "affixcmp");
+        return builder.CreateAnd(fits, builder.CreateICmpEQ(cmp, builder.getInt32(0)), name);
+    }
+
+    return nullptr;
+}
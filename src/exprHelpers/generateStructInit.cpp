@@ -1,6 +1,8 @@
 #include "../../include/CodeGen.hpp"
 
-
+// Point{x: 1, y: 2}: nilai aggregate dibangun sekali (field yang tidak disebut = 0),
+// lalu disimpan dengan satu store ke alloca baru (di top-level: initializer global kalau konstan).
+// hasilnya pointer seperti variabel struct
 llvm::Value* CodeGen::generateStructInit(const std::shared_ptr<StructExpr>& structInitStmt){
     auto it = StructTypes.find(structInitStmt->name);
     if(it == StructTypes.end())
@@ -8,27 +10,31 @@ llvm::Value* CodeGen::generateStructInit(const std::shared_ptr<StructExpr>& stru
     
     StructInfo& structInfo = it->second;
     llvm::StructType* structType = structInfo.type;
-    llvm::Function* currentFun = builder.GetInsertBlock()->getParent();
-    
-    llvm::AllocaInst* alloc = createEntryBlockAlloca(currentFun, structInitStmt->name + "_inst", structType, 1);
     
-    for(size_t i=0;i<structInitStmt->fieldsValue.size();++i){
-        auto& field = structInitStmt->fieldsValue[i];
-        unsigned fieldIndex = structInfo.fieldIndices[field.first];
-        llvm::Value* fieldPtr = builder.CreateStructGEP(structType, alloc, fieldIndex, field.first + "_ptr");
-        llvm::Value* value = generateExpression(field.second);
-        builder.CreateStore(value, fieldPtr);
+    llvm::Value* aggregate = llvm::Constant::getNullValue(structType);
+    for(const auto& [fieldName, fieldExpr] : structInitStmt->fieldsValue){
+        auto field = structInfo.fieldIndices.find(fieldName);
+        if(field == structInfo.fieldIndices.end())
+            throw std::runtime_error("Unknown field " + fieldName + " in " + structInitStmt->name);
+        unsigned fieldIndex = field->second;
+
+        llvm::Value* value = nullptr;
+        auto nested = structInfo.fieldStructs.find(fieldName);
+        if(nested != structInfo.fieldStructs.end()){
+            // field struct: salin isi struct sumber
+            std::string valueStruct;
+            llvm::Value* src = structPointer(fieldExpr, valueStruct);
+            if(valueStruct != nested->second)
+                throw std::runtime_error("Field " + fieldName + " expects a " + nested->second);
+            value = builder.CreateLoad(structType->getElementType(fieldIndex), src);
+        } else {
+            value = generateExpression(fieldExpr);
+            value = castToType(value, structType->getElementType(fieldIndex), isUnsignedType(structInfo.fieldTypes[fieldName]));
+        }
+        aggregate = builder.CreateInsertValue(aggregate, value, fieldIndex);
     }
     
-    VarInfo varInfo;
-    varInfo.alloc = alloc;
-    varInfo.dataType = LiteralType::STRUCT;
-    varInfo.structTypeName = structInitStmt->name;
-    varInfo.isArray = false;
-    varInfo.size = 1;
-    varInfo.staticType = true;
-    
-    // simpan ke stack dengan nama tipe struct sementara
-    VariablesStack.back()[structInitStmt->name] = varInfo;
+    llvm::Value* alloc = createVariableStorage(structInitStmt->name + "_inst", structType);
+    storeInitialValue(alloc, aggregate);
     return alloc;
-}
\ No newline at end of file
+}
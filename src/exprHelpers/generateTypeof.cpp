@@ -1,15 +1,5 @@
 #include "../../include/CodeGen.hpp"
 
-// Helper mapping LiteralType ke string
-static const std::unordered_map<LiteralType, std::string> literalTypeNames = {
-    {LiteralType::INT_32, "i32"},
-    {LiteralType::INT_64, "i64"},
-    {LiteralType::DOUBLE, "double"},
-    {LiteralType::BOOL, "bool"},
-    {LiteralType::STRING, "str"},
-    {LiteralType::UNKNOWN, "unknown"}
-};
-
 llvm::Value* CodeGen::generateTypeof(const std::shared_ptr<TypeofStmt>& typeOfStmtObj){
     auto expr = typeOfStmtObj->expression;
     LiteralType type = LiteralType::UNKNOWN;
@@ -26,11 +16,11 @@ llvm::Value* CodeGen::generateTypeof(const std::shared_ptr<TypeofStmt>& typeOfSt
     else {
         // fallback, bisa generate value
         llvm::Value* val = generateExpression(expr);
-        type = inferLiteralTypeFromLLVM(val->getType());
+        type = valueLiteralType(val);
         if (type == LiteralType::UNKNOWN)
             throw std::runtime_error("Unknown type in typeof");
     }
 
     // return string LLVM sesuai tipe
-    return builder.CreateGlobalStringPtr(literalTypeNames.at(type));
+    return getStringLiteral(literalTypeName(type));
 }
@@ -1,15 +1,19 @@
 #include "../../include/CodeGen.hpp"
 
 llvm::Value* CodeGen::generateUnary(const std::shared_ptr<UnaryOpStmt>& unary){
-    llvm::Value *operandVal = generateExpression(unary->operand);
-    llvm::Type* operandType = operandVal->getType();
+    return emitUnaryOp(unary->op, generateExpression(unary->operand));
+}
+
+// skalar maupun vector, aturan sama
+llvm::Value* CodeGen::emitUnaryOp(const std::string& op, llvm::Value* operandVal){
+    llvm::Type* operandType = operandVal->getType()->getScalarType();
     // if(unary->op == "+") {
         // unary plus, kembalikan apa adanya
         // return operandVal;
     // } 
-    if(unary->op == "-") {
+    if(op == "-") {
         if(operandType->isIntegerTy())
-            return builder.CreateNeg(operandVal, "negtmp");
+            return markUnsigned(builder.CreateNeg(operandVal, "negtmp"), isUnsignedValue(operandVal));
         else if(operandType->isFloatingPointTy()) // berkoma baik float atau double
             return builder.CreateFNeg(operandVal, "fnegtmp");
         else {
@@ -17,7 +21,7 @@ llvm::Value* CodeGen::generateUnary(const std::shared_ptr<UnaryOpStmt>& unary){
             return nullptr;
         }
     } 
-    else if(unary->op == "!") {
+    else if(op == "!") {
         if(operandType->isIntegerTy(1))  // boolean
             return builder.CreateNot(operandVal, "nottmp");
         else {
@@ -25,8 +29,13 @@ llvm::Value* CodeGen::generateUnary(const std::shared_ptr<UnaryOpStmt>& unary){
             return nullptr;
         }
     } 
+    else if(op == "~") {
+        if(!operandType->isIntegerTy() || operandType->isIntegerTy(1))
+            throw std::runtime_error("Operator ~ needs an integer operand, use ! for bool");
+        return markUnsigned(builder.CreateNot(operandVal, "bitnottmp"), isUnsignedValue(operandVal));
+    }
     else {
-        throw std::runtime_error("Unary operator tidak dikenali: " + unary->op + "\n");
+        throw std::runtime_error("Unary operator tidak dikenali: " + op + "\n");
         return nullptr;
     }
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "runtime.hpp"
+#include <cstdlib>
+#include <sys/mman.h>
+
+// arena per thread: alokasi kecil cukup geser pointer di chunk (bump),
+// alokasi besar dapat mapping sendiri (huge page kalau bisa).
+// tidak ada free per objek, semua dibebaskan sekaligus lewat mark / release.
+
+namespace {
+
+constexpr size_t ARENA_ALIGN = 16;
+constexpr size_t CHUNK_SIZE = 1 << 20;            // 1 MiB per chunk
+constexpr size_t LARGE_THRESHOLD = CHUNK_SIZE / 4; // lebih dari ini -> mapping sendiri
+constexpr size_t HUGE_PAGE_SIZE = 2 << 20;         // 2 MiB (THP di x86-64)
+constexpr int MAX_SPARE_CHUNKS = 8;
+
+struct Chunk {
+    Chunk* prev;
+    char* cur;
+    char* end;
+};
+
+struct alignas(ARENA_ALIGN) LargeBlock {
+    LargeBlock* prev;
+    size_t mapSize;
+};
+
+struct Arena {
+    Chunk* head = nullptr;
+    LargeBlock* large = nullptr;
+    int64_t largeCount = 0;
+    // posisi mark terakhir: blok sebelum posisi ini tidak boleh diperbesar in-place
+    Chunk* floorChunk = nullptr;
+    char* floorCur = nullptr;
+    int64_t floorLarge = 0;
+    Chunk* spare = nullptr; // chunk bekas release, dipakai ulang tanpa mmap baru
+    int spareCount = 0;
+    ~Arena();
+};
+
+thread_local Arena arena;
+
+size_t alignUp(size_t n, size_t a) { return (n + a - 1) & ~(a - 1); }
+
+void* mapOrDie(size_t bytes) {
+    void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mem == MAP_FAILED) {
+        fprintf(stderr, "Runtime Error: out of memory (%zu bytes)\n", bytes);
+        exit(1);
+    }
+    return mem;
+}
+
+char* chunkData(Chunk* c) { return reinterpret_cast<char*>(c) + alignUp(sizeof(Chunk), ARENA_ALIGN); }
+
+void newChunk() {
+    Chunk* c = arena.spare;
+    if(c) {
+        arena.spare = c->prev;
+        arena.spareCount--;
+    } else {
+        c = static_cast<Chunk*>(mapOrDie(CHUNK_SIZE));
+        c->end = reinterpret_cast<char*>(c) + CHUNK_SIZE;
+    }
+    c->cur = chunkData(c);
+    c->prev = arena.head;
+    arena.head = c;
+}
+
+void dropChunk(Chunk* c) {
+    if(arena.spareCount < MAX_SPARE_CHUNKS) {
+        c->prev = arena.spare;
+        arena.spare = c;
+        arena.spareCount++;
+    } else {
+        munmap(c, CHUNK_SIZE);
+    }
+}
+
+size_t largeMapSize(size_t bytes) {
+    size_t total = bytes + sizeof(LargeBlock);
+    return total >= HUGE_PAGE_SIZE ? alignUp(total, HUGE_PAGE_SIZE) : alignUp(total, 4096);
+}
+
+void* allocLarge(size_t bytes) {
+    size_t mapSize = largeMapSize(bytes);
+    LargeBlock* block = static_cast<LargeBlock*>(mapOrDie(mapSize));
+#ifdef MADV_HUGEPAGE
+    if(mapSize >= HUGE_PAGE_SIZE) madvise(block, mapSize, MADV_HUGEPAGE);
+#endif
+    block->prev = arena.large;
+    block->mapSize = mapSize;
+    arena.large = block;
+    arena.largeCount++;
+    return block + 1;
+}
+
+Arena::~Arena() {
+    while(large) { LargeBlock* p = large->prev; munmap(large, large->mapSize); large = p; }
+    while(head) { Chunk* p = head->prev; munmap(head, CHUNK_SIZE); head = p; }
+    while(spare) { Chunk* p = spare->prev; munmap(spare, CHUNK_SIZE); spare = p; }
+}
+
+} // namespace
+
+
+
+extern "C" void* aiko_arena_alloc(int64_t size) {
+    size_t bytes = alignUp(size > 0 ? static_cast<size_t>(size) : 1, ARENA_ALIGN);
+    if(bytes > LARGE_THRESHOLD) return allocLarge(bytes);
+
+    Chunk* c = arena.head;
+    if(!c || static_cast<size_t>(c->end - c->cur) < bytes) {
+        newChunk();
+        c = arena.head;
+    }
+    void* ptr = c->cur;
+    c->cur += bytes;
+    return ptr;
+}
+
+extern "C" void* aiko_arena_alloc_zeroed(int64_t size) {
+    size_t bytes = size > 0 ? static_cast<size_t>(size) : 0;
+    void* ptr = aiko_arena_alloc(size);
+    // mapping baru dari kernel sudah nol, chunk bisa berisi sisa data lama
+    if(alignUp(bytes, ARENA_ALIGN) <= LARGE_THRESHOLD) memset(ptr, 0, bytes);
+    return ptr;
+}
+
+// perbesar blok: in-place kalau blok adalah alokasi terakhir di chunk / mapping besar teratas
+// (dan dibuat setelah mark terakhir), selain itu alokasi baru + copy (blok lama ikut dibebaskan saat release)
+extern "C" void* aiko_arena_realloc(void* old, int64_t oldSize, int64_t newSize) {
+    if(!old) return aiko_arena_alloc(newSize);
+    size_t oldBytes = alignUp(static_cast<size_t>(oldSize), ARENA_ALIGN);
+    size_t newBytes = alignUp(static_cast<size_t>(newSize), ARENA_ALIGN);
+    if(newBytes <= oldBytes) return old;
+
+    Chunk* c = arena.head;
+    bool afterMark = c != arena.floorChunk || static_cast<char*>(old) >= arena.floorCur;
+    if(c && afterMark && static_cast<char*>(old) + oldBytes == c->cur && static_cast<size_t>(c->end - static_cast<char*>(old)) >= newBytes) {
+        c->cur = static_cast<char*>(old) + newBytes;
+        return old;
+    }
+
+    LargeBlock* top = arena.large;
+    if(top && static_cast<void*>(top + 1) == old && arena.largeCount > arena.floorLarge) {
+        size_t mapSize = largeMapSize(newBytes);
+        if(mapSize == top->mapSize) return old;
+        void* moved = mremap(top, top->mapSize, mapSize, MREMAP_MAYMOVE);
+        if(moved == MAP_FAILED) {
+            fprintf(stderr, "Runtime Error: out of memory (%zu bytes)\n", mapSize);
+            exit(1);
+        }
+        top = static_cast<LargeBlock*>(moved);
+#ifdef MADV_HUGEPAGE
+        if(mapSize >= HUGE_PAGE_SIZE) madvise(top, mapSize, MADV_HUGEPAGE);
+#endif
+        top->mapSize = mapSize;
+        arena.large = top;
+        return top + 1;
+    }
+
+    void* fresh = aiko_arena_alloc(newSize);
+    memcpy(fresh, old, static_cast<size_t>(oldSize));
+    return fresh;
+}
+
+extern "C" void aiko_arena_mark(AikoArenaMark* mark) {
+    mark->chunk = arena.head;
+    mark->cur = arena.head ? arena.head->cur : nullptr;
+    mark->largeCount = arena.largeCount;
+    mark->prevFloorChunk = arena.floorChunk;
+    mark->prevFloorCur = arena.floorCur;
+    mark->prevFloorLarge = arena.floorLarge;
+
+    arena.floorChunk = static_cast<Chunk*>(mark->chunk);
+    arena.floorCur = static_cast<char*>(mark->cur);
+    arena.floorLarge = arena.largeCount;
+}
+
+// kembalikan arena ke posisi mark, semua alokasi setelahnya dianggap mati.
+// mark tetap berlaku setelah release, jadi loop cukup mark sekali dan release tiap iterasi
+extern "C" void aiko_arena_release(const AikoArenaMark* mark) {
+    while(arena.largeCount > mark->largeCount) {
+        LargeBlock* b = arena.large;
+        arena.large = b->prev;
+        arena.largeCount--;
+        munmap(b, b->mapSize);
+    }
+    while(arena.head != mark->chunk) {
+        Chunk* c = arena.head;
+        arena.head = c->prev;
+        dropChunk(c);
+    }
+    if(arena.head) arena.head->cur = static_cast<char*>(mark->cur);
+}
+
+// tutup scope mark: release lalu kembalikan floor ke mark sebelumnya
+extern "C" void aiko_arena_pop(const AikoArenaMark* mark) {
+    aiko_arena_release(mark);
+    arena.floorChunk = static_cast<Chunk*>(mark->prevFloorChunk);
+    arena.floorCur = static_cast<char*>(mark->prevFloorCur);
+    arena.floorLarge = mark->prevFloorLarge;
+}
+
+// salinan str ke arena (diakhiri '\0' supaya tetap bisa dipakai fungsi C)
+extern "C" char* aiko_arena_strdup(const char* src, int64_t len) {
+    char* dst = static_cast<char*>(aiko_arena_alloc(len + 1));
+    memcpy(dst, src, static_cast<size_t>(len));
+    dst[len] = '\0';
+    return dst;
+}
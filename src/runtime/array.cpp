@@ -0,0 +1,47 @@
+#include "runtime.hpp"
+
+// data awal array<T>(n) dari arena, semua elemen 0
+extern "C" void* aiko_array_alloc(int64_t elemSize, int64_t count) {
+    if(count <= 0) return nullptr;
+    return aiko_arena_alloc_zeroed(elemSize * count);
+}
+
+// kapasitas naik geometris (x2) agar push rata-rata O(1)
+extern "C" void aiko_array_grow(AikoArrayHeader* header, int64_t elemSize, int64_t minCap) {
+    int64_t newCap = header->cap < 4 ? 4 : header->cap * 2;
+    if(newCap < minCap) newCap = minCap;
+
+    header->data = aiko_arena_realloc(header->data, header->cap * elemSize, newCap * elemSize);
+    header->cap = newCap;
+}
+
+// array bool: cap dalam bit, selalu kelipatan 64 (satu word i64)
+extern "C" void aiko_bitarray_grow(AikoArrayHeader* header, int64_t minCap) {
+    int64_t newCap = header->cap < 64 ? 64 : header->cap * 2;
+    if(newCap < minCap) newCap = minCap;
+    newCap = (newCap + 63) & ~int64_t(63);
+
+    header->data = aiko_arena_realloc(header->data, header->cap / 8, newCap / 8);
+    header->cap = newCap;
+}
+
+// array struct @soa: satu blok berisi kolom per field, kolom ke-k mulai di cap * (ukuran field 0..k-1).
+// cap kelipatan 8 supaya semua kolom tetap align, tumbuh = blok baru lalu tiap kolom disalin ke posisinya
+extern "C" void aiko_soa_grow(AikoArrayHeader* header, const int64_t* fieldSizes, int64_t fieldCount, int64_t minCap) {
+    int64_t newCap = header->cap < 8 ? 8 : header->cap * 2;
+    if(newCap < minCap) newCap = minCap;
+    newCap = (newCap + 7) & ~int64_t(7);
+
+    int64_t rowSize = 0;
+    for(int64_t k = 0; k < fieldCount; k++) rowSize += fieldSizes[k];
+    char* fresh = static_cast<char*>(aiko_arena_alloc_zeroed(newCap * rowSize));
+    char* old = static_cast<char*>(header->data);
+
+    int64_t offset = 0;
+    for(int64_t k = 0; k < fieldCount; k++){
+        if(header->len > 0) std::memcpy(fresh + newCap * offset, old + header->cap * offset, header->len * fieldSizes[k]);
+        offset += fieldSizes[k];
+    }
+    header->data = fresh;
+    header->cap = newCap;
+}
@@ -5,4 +5,91 @@ extern "C" void runtime_input(char* buffer) {
         // hapus newline jika ada
         buffer[strcspn(buffer, "\n")] = 0;
     }
-}
\ No newline at end of file
+}
+
+
+
+// header file binary: magic "AIKB", versi, tipe elemen, ukuran elemen, jumlah elemen
+// setelah header langsung byte mentah elemen, tanpa format apapun
+struct AikoBinHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t typeTag;
+    uint32_t elemSize;
+    uint64_t count;
+};
+
+static const char AIKO_BIN_MAGIC[4] = {'A', 'I', 'K', 'B'};
+static const uint32_t AIKO_BIN_VERSION = 1;
+
+extern "C" int64_t aiko_save(const char* pathPtr, int64_t pathLen, const void* data, int64_t elemSize, int64_t count, int32_t typeTag) {
+    std::string pathStr(pathPtr, pathLen); // str aiko tidak wajib diakhiri '\0'
+    const char* path = pathStr.c_str();
+    FILE* file = fopen(path, "wb");
+    if(!file) {
+        fprintf(stderr, "Runtime Error: cannot open %s for writing\n", path);
+        return -1;
+    }
+    setvbuf(file, nullptr, _IONBF, 0); // tulis langsung, tanpa buffer stdio
+
+    AikoBinHeader header;
+    memcpy(header.magic, AIKO_BIN_MAGIC, 4);
+    header.version = AIKO_BIN_VERSION;
+    header.typeTag = typeTag;
+    header.elemSize = static_cast<uint32_t>(elemSize);
+    header.count = static_cast<uint64_t>(count);
+
+    size_t bytes = static_cast<size_t>(elemSize * count);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && (bytes == 0 || fwrite(data, 1, bytes, file) == bytes);
+    fclose(file);
+
+    if(!ok) {
+        fprintf(stderr, "Runtime Error: failed writing %s\n", path);
+        return -1;
+    }
+    return count;
+}
+
+extern "C" int64_t aiko_load(const char* pathPtr, int64_t pathLen, void* data, int64_t elemSize, int64_t capacity, int32_t typeTag) {
+    std::string pathStr(pathPtr, pathLen);
+    const char* path = pathStr.c_str();
+    FILE* file = fopen(path, "rb");
+    if(!file) {
+        fprintf(stderr, "Runtime Error: cannot open %s for reading\n", path);
+        return -1;
+    }
+    setvbuf(file, nullptr, _IONBF, 0); // baca langsung ke memori tujuan
+
+    AikoBinHeader header;
+    if(fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, AIKO_BIN_MAGIC, 4) != 0
+        || header.version != AIKO_BIN_VERSION) {
+        fprintf(stderr, "Runtime Error: %s is not an aiko binary file\n", path);
+        fclose(file);
+        return -1;
+    }
+
+    if(header.typeTag != typeTag || header.elemSize != static_cast<uint32_t>(elemSize)) {
+        fprintf(stderr, "Runtime Error: element type in %s does not match\n", path);
+        fclose(file);
+        return -1;
+    }
+
+    if(header.count > static_cast<uint64_t>(capacity)) {
+        fprintf(stderr, "Runtime Error: %s has %llu elements, target only holds %lld\n",
+            path, (unsigned long long)header.count, (long long)capacity);
+        fclose(file);
+        return -1;
+    }
+
+    size_t bytes = static_cast<size_t>(header.count * elemSize);
+    bool ok = bytes == 0 || fread(data, 1, bytes, file) == bytes;
+    fclose(file);
+
+    if(!ok) {
+        fprintf(stderr, "Runtime Error: %s is truncated\n", path);
+        return -1;
+    }
+    return static_cast<int64_t>(header.count);
+}
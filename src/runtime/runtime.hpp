@@ -3,7 +3,49 @@
 
 #include <cstdio>
 #include <cstring>
+#include <cstdint>
+#include <string>
 
 extern "C" void runtime_input(char* buffer);
 
-#endif
\ No newline at end of file
+// dump / load data mentah (array atau struct) ke file dengan header kecil
+extern "C" int64_t aiko_save(const char* pathPtr, int64_t pathLen, const void* data, int64_t elemSize, int64_t count, int32_t typeTag);
+extern "C" int64_t aiko_load(const char* pathPtr, int64_t pathLen, void* data, int64_t elemSize, int64_t capacity, int32_t typeTag);
+
+// arena per thread (arena.cpp) untuk semua data heap program.
+// mark menyimpan posisi arena, release membuang semua alokasi setelah mark
+struct AikoArenaMark {
+    void* chunk;
+    void* cur;
+    int64_t largeCount;
+    void* prevFloorChunk;
+    void* prevFloorCur;
+    int64_t prevFloorLarge;
+};
+
+extern "C" void* aiko_arena_alloc(int64_t size);
+extern "C" void* aiko_arena_alloc_zeroed(int64_t size);
+extern "C" void* aiko_arena_realloc(void* old, int64_t oldSize, int64_t newSize);
+extern "C" void aiko_arena_mark(AikoArenaMark* mark);
+extern "C" void aiko_arena_release(const AikoArenaMark* mark);
+extern "C" void aiko_arena_pop(const AikoArenaMark* mark);
+extern "C" char* aiko_arena_strdup(const char* src, int64_t len);
+
+// array dinamis (array.cpp), header sama dengan { T* data, i64 len, i64 cap } di codegen
+struct AikoArrayHeader {
+    void* data;
+    int64_t len;
+    int64_t cap;
+};
+
+extern "C" void* aiko_array_alloc(int64_t elemSize, int64_t count);
+extern "C" void aiko_array_grow(AikoArrayHeader* header, int64_t elemSize, int64_t minCap);
+extern "C" void aiko_bitarray_grow(AikoArrayHeader* header, int64_t minCap);
+extern "C" void aiko_soa_grow(AikoArrayHeader* header, const int64_t* fieldSizes, int64_t fieldCount, int64_t minCap);
+
+// pencarian teks (strings.cpp), semua offset dalam byte, -1 kalau tidak ketemu
+extern "C" int64_t aiko_str_find(const char* hay, int64_t hayLen, const char* needle, int64_t needleLen);
+extern "C" int64_t aiko_str_count(const char* hay, int64_t hayLen, const char* needle, int64_t needleLen);
+extern "C" int64_t aiko_str_split_nth(const char* hay, int64_t hayLen, const char* sep, int64_t sepLen, int64_t n, int64_t* outLen);
+
+#endif
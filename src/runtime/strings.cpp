@@ -0,0 +1,89 @@
+#include "runtime.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// cari needle di hay: filter kandidat pakai byte pertama & terakhir needle
+// (16 posisi sekaligus dengan SSE2), lalu verifikasi kandidat dengan memcmp
+static int64_t findFrom(const char* hay, int64_t hayLen, const char* needle, int64_t needleLen, int64_t start) {
+    if(needleLen == 0) return start;
+    if(needleLen > hayLen - start) return -1;
+
+    if(needleLen == 1) { // memchr libc sudah SIMD
+        const void* found = memchr(hay + start, needle[0], static_cast<size_t>(hayLen - start));
+        return found ? static_cast<const char*>(found) - hay : -1;
+    }
+
+    int64_t i = start;
+    const int64_t last = needleLen - 1;
+
+#if defined(__SSE2__)
+    const __m128i firstByte = _mm_set1_epi8(needle[0]);
+    const __m128i lastByte = _mm_set1_epi8(needle[last]);
+
+    for(; i + last + 16 <= hayLen; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+        __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + last));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(firstByte, blockFirst), _mm_cmpeq_epi8(lastByte, blockLast));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+
+        while(mask) {
+            int bit = __builtin_ctz(mask);
+            if(memcmp(hay + i + bit + 1, needle + 1, static_cast<size_t>(needleLen - 2)) == 0)
+                return i + bit;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // sisa (atau tanpa SSE2): lompat antar kemunculan byte pertama
+    while(i + needleLen <= hayLen) {
+        const void* found = memchr(hay + i, needle[0], static_cast<size_t>(hayLen - needleLen - i + 1));
+        if(!found) return -1;
+        i = static_cast<const char*>(found) - hay;
+        if(hay[i + last] == needle[last] && memcmp(hay + i + 1, needle + 1, static_cast<size_t>(needleLen - 2)) == 0)
+            return i;
+        i++;
+    }
+    return -1;
+}
+
+extern "C" int64_t aiko_str_find(const char* hay, int64_t hayLen, const char* needle, int64_t needleLen) {
+    return findFrom(hay, hayLen, needle, needleLen, 0);
+}
+
+// jumlah kemunculan yang tidak overlap, needle kosong dihitung 0
+extern "C" int64_t aiko_str_count(const char* hay, int64_t hayLen, const char* needle, int64_t needleLen) {
+    if(needleLen == 0) return 0;
+    int64_t total = 0;
+    int64_t pos = findFrom(hay, hayLen, needle, needleLen, 0);
+    while(pos >= 0) {
+        total++;
+        pos = findFrom(hay, hayLen, needle, needleLen, pos + needleLen);
+    }
+    return total;
+}
+
+// bagian ke-n (mulai 0) dari hay yang dipisah sep
+// return offset awal bagian di hay dan panjangnya di outLen, -1 kalau bagian tidak ada
+extern "C" int64_t aiko_str_split_nth(const char* hay, int64_t hayLen, const char* sep, int64_t sepLen, int64_t n, int64_t* outLen) {
+    *outLen = 0;
+    if(n < 0) return -1;
+    if(sepLen == 0) { // tanpa pemisah: seluruh string adalah bagian ke-0
+        if(n != 0) return -1;
+        *outLen = hayLen;
+        return 0;
+    }
+
+    int64_t begin = 0;
+    for(int64_t part = 0; part < n; part++) {
+        int64_t pos = findFrom(hay, hayLen, sep, sepLen, begin);
+        if(pos < 0) return -1;
+        begin = pos + sepLen;
+    }
+
+    int64_t end = findFrom(hay, hayLen, sep, sepLen, begin);
+    *outLen = (end < 0 ? hayLen : end) - begin;
+    return begin;
+}
@@ -0,0 +1,155 @@
+#include "../../include/CodeGen.hpp"
+
+// analisis region untuk arena: apakah blok (body loop / function) mengalokasi heap,
+// dan apakah ada data heap yang bisa keluar dari blok. kalau aman, semua alokasi di blok
+// dibuang sekaligus dengan release ke mark di awal blok.
+// sengaja konservatif: ragu sedikit = dianggap keluar (tidak di-release).
+void CodeGen::scanArenaRegion(
+    const std::vector<std::shared_ptr<Stmt>>& body,
+    std::set<std::string> declared,
+    const std::string& selfName,
+    bool& allocates,
+    bool& escapes
+){
+    std::function<void(const std::shared_ptr<Stmt>&)> scanExpr;
+    std::function<void(const std::vector<std::shared_ptr<Stmt>>&, std::set<std::string>)> scanBlock;
+
+    scanExpr = [&](const std::shared_ptr<Stmt>& expr){
+        if(!expr) return;
+        switch(expr->type){
+            case StmtType::DynArrayNew:
+                allocates = true;
+                for(const auto& s : std::static_pointer_cast<DynArrayExpr>(expr)->sizes) scanExpr(s);
+                break;
+            case StmtType::Input: {
+                auto in = std::static_pointer_cast<InputStmt>(expr);
+                static const std::set<std::string> scalarInputs = {
+                    "i8", "i16", "i32", "i64", "u8", "u16", "u32", "u64", "float", "f32", "double", "f64", "bool"};
+                if(!scalarInputs.count(in->dataType)) allocates = true; // str disalin ke arena
+                scanExpr(in->expr);
+                break;
+            }
+            case StmtType::FunctionCall: {
+                auto call = std::static_pointer_cast<FunctionCallStmt>(expr);
+                for(const auto& a : call->args) scanExpr(a);
+
+                if(call->name == "push" || call->name == "reserve"){
+                    allocates = true;
+                    auto target = call->args.empty() ? nullptr : std::dynamic_pointer_cast<IdentifierStmt>(call->args[0]);
+                    if(!target || !declared.count(target->name)) escapes = true; // array luar tumbuh di dalam region
+                }
+                // function user yang belum terbukti aman bisa menyimpan data heap ke variabel luar
+                else if((module->getFunction(call->name) || GenericFunctions.count(call->name)) &&
+                        call->name != selfName && !RegionSafeFunctions.count(call->name))
+                    escapes = true;
+                break;
+            }
+            case StmtType::BinaryOp: {
+                auto bin = std::static_pointer_cast<BinaryOpStmt>(expr);
+                scanExpr(bin->left);
+                scanExpr(bin->right);
+                break;
+            }
+            case StmtType::UnaryOp: scanExpr(std::static_pointer_cast<UnaryOpStmt>(expr)->operand); break;
+            case StmtType::Typeof: scanExpr(std::static_pointer_cast<TypeofStmt>(expr)->expression); break;
+            case StmtType::ArrayAccess:
+                for(const auto& idx : std::static_pointer_cast<ArrayAccessStmt>(expr)->indices) scanExpr(idx);
+                break;
+            case StmtType::MemberAccess: scanExpr(std::static_pointer_cast<MemberAccessExpr>(expr)->object); break;
+            case StmtType::ArrayLiteral:
+                for(const auto& e : std::static_pointer_cast<ArrayLiteralStmt>(expr)->elements) scanExpr(e);
+                break;
+            case StmtType::StructInit:
+                for(const auto& f : std::static_pointer_cast<StructExpr>(expr)->fieldsValue) scanExpr(f.second);
+                break;
+            default: break;
+        }
+    };
+
+    scanBlock = [&](const std::vector<std::shared_ptr<Stmt>>& stmts, std::set<std::string> names){
+        std::swap(declared, names); // scanExpr membaca 'declared' milik blok yang sedang discan
+        for(const auto& stmt : stmts){
+            switch(stmt->type){
+                case StmtType::VarDecl: {
+                    auto decl = std::static_pointer_cast<VarDeclStmt>(stmt);
+                    scanExpr(decl->initializer);
+                    if(decl->initializer && isElementwiseExpr(decl->initializer)) allocates = true; // hasil array dinamis baru
+                    declared.insert(decl->name);
+                    break;
+                }
+                case StmtType::Assignment: {
+                    auto assign = std::static_pointer_cast<AssignmentStmt>(stmt);
+                    scanExpr(assign->value);
+                    for(const auto& idx : assign->indices) scanExpr(idx);
+                    if(!declared.count(assign->name)){
+                        // nilai yang bisa menunjuk ke heap (str, struct, array dinamis) ditulis ke variabel luar
+                        VarInfo* outer = lookupVariable(assign->name);
+                        if(!outer || outer->dataType == LiteralType::STRING || outer->dataType == LiteralType::STRUCT
+                            || !outer->structTypeName.empty() || outer->isDynamic)
+                            escapes = true;
+                    }
+                    break;
+                }
+                case StmtType::Print: scanExpr(std::static_pointer_cast<PrintStmt>(stmt)->expression); break;
+                case StmtType::Return: scanExpr(std::static_pointer_cast<ReturnStmt>(stmt)->value); break;
+                case StmtType::If: {
+                    auto ifStmt = std::static_pointer_cast<IfStmt>(stmt);
+                    scanExpr(ifStmt->condition);
+                    scanBlock(ifStmt->then_block, declared);
+                    for(const auto& elif : ifStmt->elifs){
+                        scanExpr(elif->condition);
+                        scanBlock(elif->block, declared);
+                    }
+                    scanBlock(ifStmt->else_block, declared);
+                    break;
+                }
+                case StmtType::For: {
+                    auto forStmt = std::static_pointer_cast<ForStmt>(stmt);
+                    scanExpr(forStmt->start);
+                    scanExpr(forStmt->end);
+                    scanExpr(forStmt->step);
+                    std::set<std::string> inner = declared;
+                    inner.insert(forStmt->var_name);
+                    scanBlock(forStmt->block, inner);
+                    break;
+                }
+                case StmtType::FunctionDecl:
+                case StmtType::StructDecl:
+                    escapes = true; // deklarasi di dalam blok: tidak dianalisis
+                    break;
+                case StmtType::Break:
+                case StmtType::Continue:
+                    break;
+                default:
+                    scanExpr(stmt); // expression statement (misal push(a, 1))
+                    break;
+            }
+        }
+        std::swap(declared, names);
+    };
+
+    scanBlock(body, declared);
+}
+
+
+
+// simpan posisi arena, hasilnya pointer ke mark (dipakai release / pop)
+llvm::Value* CodeGen::beginArenaScope(){
+    llvm::Function* func = builder.GetInsertBlock()->getParent();
+    llvm::Type* markTy = llvm::ArrayType::get(builder.getInt64Ty(), 6); // sama dengan AikoArenaMark
+    llvm::AllocaInst* markAlloc = createEntryBlockAlloca(func, "arena_mark", markTy);
+    llvm::Value* mark = builder.CreateBitCast(markAlloc, builder.getInt8PtrTy(), "mark");
+
+    llvm::FunctionCallee markFunc = module->getOrInsertFunction("aiko_arena_mark",
+        llvm::FunctionType::get(builder.getVoidTy(), {builder.getInt8PtrTy()}, false));
+    builder.CreateCall(markFunc, {mark});
+    return mark;
+}
+
+// release: buang alokasi setelah mark (mark tetap bisa dipakai lagi)
+// pop: release + tutup scope mark
+void CodeGen::releaseArenaScope(llvm::Value* mark, bool pop){
+    llvm::FunctionCallee func = module->getOrInsertFunction(pop ? "aiko_arena_pop" : "aiko_arena_release",
+        llvm::FunctionType::get(builder.getVoidTy(), {builder.getInt8PtrTy()}, false));
+    builder.CreateCall(func, {mark});
+}
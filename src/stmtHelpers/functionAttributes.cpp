@@ -0,0 +1,77 @@
+#include "../../include/CodeGen.hpp"
+
+// @inline / @noinline / @cold dari source (sudah divalidasi di handleFunctionDecl)
+void CodeGen::applyFunctionAnnotations(llvm::Function* function, const std::vector<std::string>& annotations){
+    bool inlined = false, notInlined = false;
+    for(const auto& annotation : annotations){
+        if(annotation == "inline") inlined = true;
+        else if(annotation == "noinline") notInlined = true;
+        else if(annotation == "cold") function->addFnAttr(llvm::Attribute::Cold);
+    }
+    if(inlined && notInlined)
+        throw std::runtime_error(function->getName().str() + ": @inline and @noinline cannot be used together");
+    if(inlined) function->addFnAttr(llvm::Attribute::AlwaysInline);
+    if(notInlined) function->addFnAttr(llvm::Attribute::NoInline);
+}
+
+// pointer dasar dari GEP / bitcast (instruksi maupun constant expression)
+llvm::Value* CodeGen::baseObject(llvm::Value* ptr){
+    while(true){
+        if(auto* gep = llvm::dyn_cast<llvm::GEPOperator>(ptr)) ptr = gep->getPointerOperand();
+        else if(auto* cast = llvm::dyn_cast<llvm::BitCastOperator>(ptr)) ptr = cast->getOperand(0);
+        else return ptr;
+    }
+}
+
+// atribut yang terbukti dari IR body yang sudah jadi. nounwind selalu (bahasa ini tidak punya exception,
+// runtime error memanggil exit). readnone / readonly kalau memori luar yang disentuh hanya dibaca
+// (alloca sendiri dan global constant tidak dihitung), willreturn kalau tidak ada loop / rekursi
+// dan semua function yang dipanggil juga willreturn
+void CodeGen::inferFunctionAttributes(llvm::Function* function){
+    function->addFnAttr(llvm::Attribute::NoUnwind);
+
+    bool reads = false, writes = false, returns = true;
+    for(llvm::BasicBlock& block : *function){
+        for(llvm::Instruction& inst : block){
+            if(auto* load = llvm::dyn_cast<llvm::LoadInst>(&inst)){
+                llvm::Value* base = baseObject(load->getPointerOperand());
+                auto* global = llvm::dyn_cast<llvm::GlobalVariable>(base);
+                if(!llvm::isa<llvm::AllocaInst>(base) && !(global && global->isConstant())) reads = true;
+            }
+            else if(auto* store = llvm::dyn_cast<llvm::StoreInst>(&inst)){
+                if(!llvm::isa<llvm::AllocaInst>(baseObject(store->getPointerOperand()))) writes = true;
+            }
+            else if(auto* call = llvm::dyn_cast<llvm::CallInst>(&inst)){
+                llvm::Function* callee = call->getCalledFunction();
+                if(callee == function){ // rekursi: memori yang disentuh sama dengan function ini
+                    returns = false;
+                    continue;
+                }
+                if(!callee || !callee->doesNotAccessMemory()){
+                    reads = true;
+                    if(!callee || !callee->onlyReadsMemory()) writes = true;
+                }
+                if(!callee || !callee->hasFnAttribute(llvm::Attribute::WillReturn)) returns = false;
+            }
+            else if(inst.mayReadOrWriteMemory()){
+                reads = writes = true;
+            }
+        }
+    }
+
+    // loop = back edge di CFG, belum tentu berhenti
+    std::map<llvm::BasicBlock*, int> state; // 1 = sedang ditelusuri, 2 = selesai
+    std::function<bool(llvm::BasicBlock*)> cyclic = [&](llvm::BasicBlock* block){
+        state[block] = 1;
+        for(llvm::BasicBlock* succ : llvm::successors(block)){
+            if(state[succ] == 1 || (state[succ] == 0 && cyclic(succ))) return true;
+        }
+        state[block] = 2;
+        return false;
+    };
+    if(cyclic(&function->getEntryBlock())) returns = false;
+
+    if(!reads && !writes) function->setDoesNotAccessMemory();
+    else if(!writes) function->setOnlyReadsMemory();
+    if(returns) function->addFnAttr(llvm::Attribute::WillReturn);
+}
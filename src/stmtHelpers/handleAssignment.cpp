@@ -2,44 +2,145 @@
 
 void CodeGen::handleAssignment(const std::shared_ptr<AssignmentStmt>& assignmentStmt){
     std::string name = assignmentStmt->name;
+
+    // p.x = v / p.pos.x = v / pts[i].x = v: tulis langsung ke field
+    VarInfo* target = lookupVariable(name);
+    bool structArray = target && target->isArray && target->dataType == LiteralType::STRUCT;
+    if(!assignmentStmt->members.empty()){
+        if(!assignmentStmt->indices.empty() && !structArray) throw std::runtime_error("Error: " + name + " is not an array of structs");
+        const auto& members = assignmentStmt->members;
+        std::shared_ptr<Stmt> object = std::make_shared<IdentifierStmt>(name);
+        if(!assignmentStmt->indices.empty()) object = std::make_shared<ArrayAccessStmt>(name, assignmentStmt->indices);
+        for(size_t i = 0; i + 1 < members.size(); i++) object = std::make_shared<MemberAccessExpr>(object, members[i]);
+
+        std::string structName;
+        const std::string& fieldName = members.back();
+        llvm::Value* fieldPtr = memberPointer(object, fieldName, structName);
+        StructInfo& info = StructTypes.at(structName);
+        llvm::Type* fieldTy = fieldPtr->getType()->getPointerElementType();
+
+        auto nested = info.fieldStructs.find(fieldName);
+        if(nested != info.fieldStructs.end()){
+            std::string srcName;
+            llvm::Value* src = structPointer(assignmentStmt->value, srcName);
+            if(srcName != nested->second) throw std::runtime_error("Error: field " + fieldName + " expects a " + nested->second);
+            builder.CreateStore(builder.CreateLoad(fieldTy, src), fieldPtr);
+            return;
+        }
+        llvm::Value* val = generateExpression(assignmentStmt->value);
+        if((val->getType()->isIntegerTy() || val->getType()->isFloatingPointTy()) != (fieldTy->isIntegerTy() || fieldTy->isFloatingPointTy()) ||
+           (!fieldTy->isIntegerTy() && !fieldTy->isFloatingPointTy() && val->getType() != fieldTy))
+            throw std::runtime_error("Error: cannot assign value with different type to field " + fieldName);
+        builder.CreateStore(castToType(val, fieldTy, isUnsignedType(info.fieldTypes[fieldName])), fieldPtr);
+        return;
+    }
+
+    // pts[i] = p: elemen array struct diganti utuh
+    if(structArray){
+        if(assignmentStmt->indices.empty()) throw std::runtime_error("Error: cannot assign to the whole array of structs " + name);
+        std::string srcName;
+        llvm::Value* src = structPointer(assignmentStmt->value, srcName);
+        if(srcName != target->structTypeName) throw std::runtime_error("Error: elements of " + name + " are " + target->structTypeName);
+        std::vector<llvm::Value*> indices;
+        for(const auto& idx : assignmentStmt->indices) indices.push_back(generateExpression(idx));
+        llvm::Value* linear = generateArrayIndex(target, indices);
+        storeStructElement(target, linear, builder.CreateLoad(StructTypes.at(srcName).type, src));
+        return;
+    }
+
+    // array utuh di kiri (c = a * b, a += 1.5, a = 0): satu loop elementwise
+    VarInfo* targetArr = target;
+
+    // a = f(x) dengan f mengembalikan array: array dinamis milik sendiri cukup ganti header,
+    // array statis / parameter disalin (panjang harus sama)
+    auto call = std::dynamic_pointer_cast<FunctionCallStmt>(assignmentStmt->value);
+    bool userCall = call && (Functions.count(call->name) || GenericFunctions.count(call->name));
+    if(targetArr && targetArr->isArray && assignmentStmt->indices.empty() && userCall){
+        llvm::Value* returned = generateExpression(call);
+        auto called = CallResults.find(returned);
+        if(called == CallResults.end() || !Functions.at(called->second).returnsArray)
+            throw std::runtime_error("Error: " + call->name + " does not return an array");
+        if(Functions.at(called->second).returnType != targetArr->dataType)
+            throw std::runtime_error("Error: " + call->name + " returns an array of a different element type than " + name);
+        VarInfo result = { returned, targetArr->dataType, true, 0 };
+        result.isDynamic = true;
+        if(targetArr->isDynamic && !targetArr->isBorrowed && getArrayRank(targetArr) == 1){
+            builder.CreateStore(builder.CreateLoad(result.storageType(), result.alloc), targetArr->alloc);
+            return;
+        }
+        llvm::Value* len = getArrayLength(targetArr);
+        genRuntimeError(builder.CreateICmpNE(getArrayLength(&result), len), "Runtime Error: Array length mismatch in assignment");
+        llvm::Value* count = isBitArray(targetArr) ? bitWordCount(len) : len;
+        llvm::Type* storageTy = isBitArray(targetArr) ? builder.getInt64Ty() : getArrayElementType(targetArr);
+        builder.CreateMemCpy(getArrayDataPtr(targetArr), llvm::MaybeAlign(), getArrayDataPtr(&result), llvm::MaybeAlign(),
+                             builder.CreateMul(count, llvm::ConstantExpr::getSizeOf(storageTy)));
+        return;
+    }
+
+    if(targetArr && targetArr->isArray && assignmentStmt->indices.empty()){
+        generateElementwise(name, assignmentStmt->value, false);
+        return;
+    }
+
     llvm::Value* newVal = generateExpression(assignmentStmt->value);
-    if(!newVal) std::runtime_error("Error generating assignment value"); 
+    if(!newVal) throw std::runtime_error("Error generating assignment value"); 
     
     // ambil info variabel lama
     VarInfo* oldVar = lookupVariable(name);
-    if(!oldVar) std::runtime_error("Variable not found");
+    if(!oldVar) throw std::runtime_error("Variable not found");
     LiteralType oldType = oldVar->dataType;
+
+    // struct = struct (variabel lain / hasil function): salin isinya
+    if(!oldVar->structTypeName.empty() && assignmentStmt->indices.empty() && newVal->getType()->isPointerTy() &&
+       newVal->getType()->getPointerElementType() == oldVar->storageType()){
+        builder.CreateStore(builder.CreateLoad(oldVar->storageType(), newVal), oldVar->alloc);
+        return;
+    }
+    if(!oldVar->isArray && oldType != LiteralType::STRUCT && oldType != LiteralType::UNKNOWN)
+        newVal = adaptLiteral(assignmentStmt->value, newVal, literalTypeToLLVM(oldType), isUnsignedType(oldType));
     
     // tentukan tipe value baru
     LiteralType newType;
     switch(assignmentStmt->value->type){
-        case StmtType::Literal: 
-            newType = std::static_pointer_cast<LiteralStmt>(assignmentStmt->value)->dataType;
-            break;
         case StmtType::Identifier:
-            newType = VariablesStack.back()[std::static_pointer_cast<IdentifierStmt>(assignmentStmt->value)->name].dataType;
-            break;
-        case StmtType::UnaryOp:
-        case StmtType::BinaryOp:
-            newType = LiteralType::INT_32; // asumsi default INT_32
+        {
+            VarInfo* srcVar = lookupVariable(std::static_pointer_cast<IdentifierStmt>(assignmentStmt->value)->name);
+            if(!srcVar) throw std::runtime_error("Variable not found");
+            newType = srcVar->dataType;
             break;
-        default:
-            newType = LiteralType::INT_32;
+        }
+        default: // operasi, call, dll: tipe diambil dari value hasil generate
+            newType = valueLiteralType(newVal);
+            // konstanta (literal yang sudah ikut tipe variabel) tidak membawa tanda unsigned
+            if(llvm::isa<llvm::Constant>(newVal) && newVal->getType() == literalTypeToLLVM(oldType)) newType = oldType;
             break;
     }
 
     // assignment ke elemen array
-    if(assignmentStmt->index){
+    if(!assignmentStmt->indices.empty()){
         if(newType != oldVar->dataType) std::runtime_error("Error: cannot assign value with different type to array element");
 
-        llvm::Value *idxVal = generateExpression(assignmentStmt->index);
-        llvm::Value* elemPtr = generateArrayElementPtr(oldVar, idxVal);
+        std::vector<llvm::Value*> indices;
+        for(const auto& idx : assignmentStmt->indices) indices.push_back(generateExpression(idx));
+        llvm::Value* linear = generateArrayIndex(oldVar, indices);
 
-        builder.CreateStore(newVal, elemPtr);
+        llvm::Value* elemVal = castToType(newVal, getArrayElementType(oldVar), isUnsignedType(oldVar->dataType));
+        storeArrayLanes(oldVar, getArrayDataPtr(oldVar), linear, elemVal);
         return;
     }
     else if(oldVar->isArray) std::runtime_error("Error: cannot assign single value to array directly. Use index.");
 
+    // variabel scope luar (misal acc = acc + f() di dalam loop): alloca baru hanya terlihat di scope ini
+    // dan iterasi berikutnya masih membaca alloca lama, jadi angka dikonversi ke tipe variabel
+    llvm::Type* oldLLVMType = oldType == LiteralType::UNKNOWN || oldType == LiteralType::STRUCT ? nullptr : literalTypeToLLVM(oldType);
+    bool outerScope = !VariablesStack.back().count(name);
+    if(newType != oldType && outerScope && oldLLVMType && !oldVar->staticType &&
+       (oldLLVMType->isIntegerTy() || oldLLVMType->isFloatingPointTy()) &&
+       (newVal->getType()->isIntegerTy() || newVal->getType()->isFloatingPointTy())){
+        newVal = castToType(newVal, oldLLVMType, isUnsignedType(oldType));
+        newType = oldType;
+    }
+
     // untuk variabel non array, jika tipe berubah, buat alloca baru
     if(newType != oldType){
         if(oldVar->staticType){
@@ -48,11 +149,7 @@ void CodeGen::handleAssignment(const std::shared_ptr<AssignmentStmt>& assignment
         else {
             llvm::Type* llvmType = literalTypeToLLVM(newType);
         
-            llvm::AllocaInst* newAlloc = createEntryBlockAlloca(
-                builder.GetInsertBlock()->getParent(),
-                name,
-                llvmType
-            );
+            llvm::Value* newAlloc = createVariableStorage(name, llvmType);
 
             builder.CreateStore(newVal, newAlloc);
             VariablesStack.back()[name] = { newAlloc, newType, false, 1, false };
@@ -60,7 +157,7 @@ void CodeGen::handleAssignment(const std::shared_ptr<AssignmentStmt>& assignment
         }
     }
     
-    // store value baru
-    builder.CreateStore(newVal, VariablesStack.back()[name].alloc);
+    // store value baru ke variabel aslinya (bisa berada di scope luar, misal dari dalam loop)
+    builder.CreateStore(newVal, oldVar->alloc);
     
 }
\ No newline at end of file
@@ -2,27 +2,46 @@
 
 void CodeGen::handleFor(const std::shared_ptr<ForStmt>& forStmt){
     std::string name = forStmt->var_name;
-    llvm::Value *start = generateExpression(forStmt->start);
-    llvm::Value *end = generateExpression(forStmt->end);
+    // batas bisa berupa ekspresi i64 (misal len(arr)), index loop tetap i32
+    llvm::Value *start = builder.CreateSExtOrTrunc(generateExpression(forStmt->start), builder.getInt32Ty());
+    llvm::Value *end = builder.CreateSExtOrTrunc(generateExpression(forStmt->end), builder.getInt32Ty());
     llvm::Value* one = llvm::ConstantInt::get(context, llvm::APInt(32, 1));
     llvm::Value* endMinusOne = builder.CreateSub(end, one, "end_minus_1");        
     llvm::Value *step = generateExpression(forStmt->step);
+
+    // batas konstan (literal / hasil constant folding): jumlah iterasi sudah diketahui.
+    // 0 iterasi -> body tidak di-generate, minimal 1 -> cek kondisi pertama dilewati
+    auto* startConst = llvm::dyn_cast<llvm::ConstantInt>(start);
+    auto* endConst = llvm::dyn_cast<llvm::ConstantInt>(end);
+    bool entersBody = false;
+    if(startConst && endConst){
+        if(startConst->getSExtValue() > endConst->getSExtValue() - 1) return;
+        entersBody = true;
+    }
     
+    // loop bisa berada di dalam function, bukan hanya main
+    llvm::Function *currentFunc = builder.GetInsertBlock()->getParent();
+
     // alokasi index
-    llvm::AllocaInst *allocIndex = createEntryBlockAlloca(mainFun, name, builder.getInt32Ty());
+    llvm::AllocaInst *allocIndex = createEntryBlockAlloca(currentFunc, name, builder.getInt32Ty());
     builder.CreateStore(start, allocIndex);
     
     // basic block
-    llvm::BasicBlock *loopCondBB = llvm::BasicBlock::Create(context, "loop_cond", mainFun);
-    llvm::BasicBlock *loopBodyBB = llvm::BasicBlock::Create(context, "loop_body", mainFun);
-    llvm::BasicBlock *loopIncBB  = llvm::BasicBlock::Create(context, "loop_inc", mainFun);
-    llvm::BasicBlock *loopEndBB  = llvm::BasicBlock::Create(context, "loop_end", mainFun);
+    llvm::BasicBlock *loopCondBB = llvm::BasicBlock::Create(context, "loop_cond", currentFunc);
+    llvm::BasicBlock *loopBodyBB = llvm::BasicBlock::Create(context, "loop_body", currentFunc);
+    llvm::BasicBlock *loopIncBB  = llvm::BasicBlock::Create(context, "loop_inc", currentFunc);
+    llvm::BasicBlock *loopEndBB  = llvm::BasicBlock::Create(context, "loop_end", currentFunc);
     
     BreakTargets.push_back(loopEndBB);
     ContinueTargets.push_back(loopIncBB);    
 
+    // heap yang dialokasi body (dan tidak keluar dari body) dibuang tiap akhir iterasi
+    bool allocates = false, escapes = false;
+    scanArenaRegion(forStmt->block, {name}, "", allocates, escapes);
+    llvm::Value* arenaMark = (allocates && !escapes) ? beginArenaScope() : nullptr;
+
     // branch dari current ke condition
-    builder.CreateBr(loopCondBB);
+    builder.CreateBr(entersBody ? loopBodyBB : loopCondBB);
     
     // block kondisi
     builder.SetInsertPoint(loopCondBB);
@@ -51,6 +70,7 @@ void CodeGen::handleFor(const std::shared_ptr<ForStmt>& forStmt){
     
     // Increment block
     builder.SetInsertPoint(loopIncBB);
+    if(arenaMark) releaseArenaScope(arenaMark, false);
     llvm::Value *currentIndexInc = builder.CreateLoad(builder.getInt32Ty(), allocIndex, name);
     llvm::Value *nextIndex = builder.CreateAdd(currentIndexInc, step, "nexti");
     builder.CreateStore(nextIndex, allocIndex);
@@ -58,6 +78,7 @@ void CodeGen::handleFor(const std::shared_ptr<ForStmt>& forStmt){
     
     // End block
     builder.SetInsertPoint(loopEndBB);
+    if(arenaMark) releaseArenaScope(arenaMark, true);
     BreakTargets.pop_back();
     ContinueTargets.pop_back();
 }
\ No newline at end of file
@@ -1,87 +1,313 @@
 #include "../../include/CodeGen.hpp"
 
+// tipe return llvm: struct besar / array lewat sret (void), struct kecil by value, tanpa nilai = void
+llvm::Type* CodeGen::functionReturnType(const FunctionInfo& info){
+    if (info.sret || info.returnType == LiteralType::UNKNOWN) return builder.getVoidTy();
+    if (!info.returnStruct.empty()) return StructTypes.at(info.returnStruct).type;
+    return literalTypeToLLVM(info.returnType);
+}
+
 void CodeGen::handleFunctionDecl(const std::shared_ptr<FunctionDeclStmt>& funcDecl){    
-    // buat tipe parameter
-    std::vector<llvm::Type*> paramTypes;
+    for (const auto& annotation : funcDecl->annotations)
+        if (annotation != "inline" && annotation != "noinline" && annotation != "cold")
+            throw std::runtime_error("Unknown function annotation: @" + annotation);
+
+    // parameter tanpa tipe: function generic, instance dibuat saat dipanggil (lihat instantiateGeneric)
+    for (const auto& p : funcDecl->params) {
+        if (!std::static_pointer_cast<VarDeclStmt>(p)->hasExplicit) {
+            GenericFunctions[funcDecl->name] = { funcDecl, VariablesStack.size() };
+            return;
+        }
+    }
+
+    FunctionInfo info;
     for (size_t i = 0; i < funcDecl->params.size(); i++) {
         auto varDecl = std::static_pointer_cast<VarDeclStmt>(funcDecl->params[i]);
-        llvm::Type* argTy;
-        if (varDecl->hasExplicit) {
-            argTy = literalTypeToLLVM(varDecl->varType);
+        if (!varDecl->structName.empty() && !StructTypes.count(varDecl->structName))
+            throw std::runtime_error("Unknown struct type: " + varDecl->structName);
+        ParamInfo param = { varDecl->name, varDecl->varType, varDecl->isArray };
+        param.structName = varDecl->structName;
+        info.params.push_back(param);
+    }
+    scanParamWrites(funcDecl, info.params);
+
+    if (funcDecl->hasReturnType) {
+        if (!funcDecl->returnStruct.empty() && !StructTypes.count(funcDecl->returnStruct))
+            throw std::runtime_error("Unknown struct type: " + funcDecl->returnStruct);
+        info.returnType = funcDecl->returnType;
+        info.returnStruct = funcDecl->returnStruct;
+        info.returnsArray = funcDecl->returnsArray;
+    } else {
+        inferReturnType(funcDecl, info);
+    }
+
+    // function ini bisa dibuat di tengah generate percobaan function lain, return-nya bukan milik function itu
+    FunctionInfo* outerInferring = InferringReturn;
+    InferringReturn = nullptr;
+    auto* oldBlock = builder.GetInsertBlock(); // simpan posisi builder lama untuk kembali ke sebelumnya (contoh: main)
+    emitFunction(funcDecl, info);
+    if (oldBlock) builder.SetInsertPoint(oldBlock);
+    InferringReturn = outerInferring;
+}
+
+
+// tipe return tanpa deklarasi: body di-generate sebagai percobaan, handleReturn mencatat tipe tiap nilai
+// yang dikembalikan, lalu function percobaan dibuang. diulang kalau panggilan rekursif ikut mengubah tipe
+void CodeGen::inferReturnType(const std::shared_ptr<FunctionDeclStmt>& funcDecl, FunctionInfo& info){
+    FunctionInfo trial = info;
+    trial.returnType = LiteralType::INT_32; // sementara untuk panggilan rekursif
+    auto* oldBlock = builder.GetInsertBlock();
+    std::set<llvm::Value*> oldUnsigned = UnsignedValues;
+    auto oldCallResults = CallResults;
+
+    for (int attempt = 0; attempt < 3; attempt++) {
+        std::set<llvm::Function*> existing;
+        for (llvm::Function& f : *module) existing.insert(&f);
+
+        FunctionInfo seen = info;
+        FunctionInfo* outerInferring = InferringReturn;
+        InferringReturn = &seen;
+        llvm::Function* function = emitFunction(funcDecl, trial);
+        InferringReturn = outerInferring;
+
+        // buang function percobaan (termasuk function yang dideklarasikan di dalamnya)
+        std::vector<llvm::Function*> created;
+        for (llvm::Function& f : *module)
+            if (!existing.count(&f) && !f.isDeclaration()) created.push_back(&f);
+        for (llvm::Function* f : created) {
+            if (f == function) continue;
+            f->replaceAllUsesWith(llvm::UndefValue::get(f->getType()));
+            f->eraseFromParent();
+        }
+        function->replaceAllUsesWith(llvm::UndefValue::get(function->getType()));
+        function->eraseFromParent();
+        UnsignedValues = oldUnsigned; // value yang sudah dihapus tidak boleh tertinggal di sini
+        CallResults = oldCallResults;
+
+        bool same = seen.returnType == trial.returnType && seen.returnStruct == trial.returnStruct &&
+                    seen.returnsArray == trial.returnsArray;
+        trial = seen;
+        if (same) break;
+    }
+    if (oldBlock) builder.SetInsertPoint(oldBlock);
+
+    info.returnType = trial.returnType;
+    info.returnStruct = trial.returnStruct;
+    info.returnsArray = trial.returnsArray;
+}
+
+
+// buat llvm::Function dari deklarasi dengan signature info, lalu generate body-nya
+llvm::Function* CodeGen::emitFunction(const std::shared_ptr<FunctionDeclStmt>& funcDecl, FunctionInfo& info){
+    const std::vector<ParamInfo>& params = info.params;
+
+    // buat tipe parameter, array = 2 argumen llvm: pointer data + panjang.
+    // hasil struct besar / array ditulis ke buffer pemanggil (argumen pertama, sret)
+    llvm::Type* sretTy = nullptr;
+    if (!info.returnStruct.empty() && !structInRegisters(StructTypes.at(info.returnStruct).type))
+        sretTy = StructTypes.at(info.returnStruct).type;
+    else if (info.returnsArray)
+        sretTy = getDynArrayType(info.returnType == LiteralType::BOOL ? builder.getInt64Ty() : literalTypeToLLVM(info.returnType));
+    info.sret = sretTy != nullptr;
+    Functions[funcDecl->name] = info;
+
+    std::vector<llvm::Type*> paramTypes;
+    if (sretTy) paramTypes.push_back(sretTy->getPointerTo());
+    for (const ParamInfo& param : params) {
+        if (param.isArray) {
+            // array bool: data berupa word i64. array struct @soa: blok kolom + cap (jarak antar kolom)
+            bool soa = !param.structName.empty() && StructTypes.at(param.structName).soa;
+            llvm::Type* elemTy = param.dataType == LiteralType::BOOL ? builder.getInt64Ty() : literalTypeToLLVM(param.dataType);
+            if (!param.structName.empty()) elemTy = soa ? builder.getInt8Ty() : static_cast<llvm::Type*>(StructTypes.at(param.structName).type);
+            paramTypes.push_back(elemTy->getPointerTo());
+            paramTypes.push_back(builder.getInt64Ty());
+            if (soa) paramTypes.push_back(builder.getInt64Ty());
         }
-        else { // default, diubah nanti
-            argTy = builder.getInt32Ty();
+        else if (!param.structName.empty()) {
+            llvm::StructType* structTy = StructTypes.at(param.structName).type;
+            paramTypes.push_back(structInRegisters(structTy) ? static_cast<llvm::Type*>(structTy) : structTy->getPointerTo());
+        }
+        else {
+            paramTypes.push_back(literalTypeToLLVM(param.dataType));
         }
-        paramTypes.push_back(argTy);
     }
 
-    // buat fun
-    llvm::Type* retType = builder.getInt32Ty();
-    llvm::FunctionType *funcType = llvm::FunctionType::get(retType, paramTypes, false);
+    // buat fun: hanya dipanggil dari module ini, jadi internal + fastcc (llvm bebas inline / ubah signature,
+    // function yang tidak terpakai setelah inline bisa dibuang)
+    llvm::FunctionType *funcType = llvm::FunctionType::get(functionReturnType(info), paramTypes, false);
     llvm::Function* function = llvm::Function::Create(
         funcType,
-        llvm::Function::ExternalLinkage,
+        llvm::Function::InternalLinkage,
         funcDecl->name,
         module.get()
     );
+    function->setCallingConv(llvm::CallingConv::Fast);
+    applyFunctionAnnotations(function, funcDecl->annotations);
+
+    unsigned argNo = 0;
+    if (sretTy) {
+        function->addParamAttr(0, llvm::Attribute::getWithStructRetType(context, sretTy));
+        function->addParamAttr(0, llvm::Attribute::NoAlias);
+        function->getArg(0)->setName("ret");
+        argNo++;
+    }
+
+    // array / struct global bisa dikirim sebagai argumen sekaligus dibaca langsung di body,
+    // function seperti itu tidak boleh menganggap parameter pointer-nya noalias
+    bool usesGlobalData = false;
+    std::function<void(const std::shared_ptr<Stmt>&)> scanGlobals = [&](const std::shared_ptr<Stmt>& stmt){
+        std::string name;
+        if (stmt->type == StmtType::Identifier) name = std::static_pointer_cast<IdentifierStmt>(stmt)->name;
+        else if (stmt->type == StmtType::ArrayAccess) name = std::static_pointer_cast<ArrayAccessStmt>(stmt)->array_name;
+        else if (stmt->type == StmtType::Assignment) name = std::static_pointer_cast<AssignmentStmt>(stmt)->name;
+        else if (stmt->type == StmtType::FunctionCall && GlobalDataUsers.count(std::static_pointer_cast<FunctionCallStmt>(stmt)->name))
+            usesGlobalData = true;
+        VarInfo* var = name.empty() ? nullptr : lookupVariable(name);
+        if (var && llvm::isa<llvm::GlobalVariable>(var->alloc) && (var->isArray || var->dataType == LiteralType::STRUCT))
+            usesGlobalData = true;
+        forEachChild(stmt, scanGlobals);
+    };
+    for (const auto& s : funcDecl->body) scanGlobals(s);
+    if (usesGlobalData) GlobalDataUsers.insert(funcDecl->name);
+
+    // data array parameter: tidak disimpan keluar function (nocapture), tidak tumpang tindih dengan
+    // array parameter lain yang ditulis (dicek di setiap pemanggilan), readonly kalau tidak pernah ditulis.
+    // dengan ini llvm bisa vectorize loop di dalam function tanpa runtime alias check
+    // struct besar: pointer ke struct pemanggil, hanya dibaca (function menyalin ke alloca sendiri)
+    for (const ParamInfo& param : params) {
+        if (!param.isArray && !param.structName.empty() && function->getArg(argNo)->getType()->isPointerTy()) {
+            if (!usesGlobalData) function->addParamAttr(argNo, llvm::Attribute::NoAlias);
+            function->addParamAttr(argNo, llvm::Attribute::NoCapture);
+            function->addParamAttr(argNo, llvm::Attribute::ReadOnly);
+        }
+        if (param.isArray) {
+            if (!usesGlobalData) function->addParamAttr(argNo, llvm::Attribute::NoAlias);
+            function->addParamAttr(argNo, llvm::Attribute::NoCapture);
+            if (!param.writes) function->addParamAttr(argNo, llvm::Attribute::ReadOnly);
+            argNo++;
+            if (!param.structName.empty() && StructTypes.at(param.structName).soa) argNo++;
+        }
+        argNo++;
+    }
 
     // entry block
     llvm::BasicBlock* entry = llvm::BasicBlock::Create(context, "entry", function);
-    auto* oldBlock = builder.GetInsertBlock(); // simpan posisi builder lama untuk kembali ke sebelumnya
     builder.SetInsertPoint(entry);
 
     VariablesStack.emplace_back();
     // mapping args ke allocas
     auto argIter = function->arg_begin();
-    for (size_t i = 0; i < funcDecl->params.size(); i++, argIter++) {
-        auto varDecl = std::static_pointer_cast<VarDeclStmt>(funcDecl->params[i]);
-        llvm::Type* argTy;
-        LiteralType varType;
-        if (varDecl->hasExplicit) {
-            argTy = literalTypeToLLVM(varDecl->varType);
-            varType = varDecl->varType;
-        } else {
-            argTy = builder.getInt32Ty(); // default
-            varType = LiteralType::INT_32; // default agar variable bisa dikenali
+    if (sretTy) argIter++;
+    for (const ParamInfo& param : params) {
+        const std::string& paramName = param.name;
+
+        if (param.isArray) {
+            // header lokal { data, len, cap } supaya semua operasi array dinamis bisa dipakai langsung,
+            // data tetap milik pemanggil (tidak disalin)
+            llvm::Value* data = &*argIter++;
+            llvm::Value* len = &*argIter++;
+            llvm::Value* cap = len;
+            data->setName(paramName + ".data");
+            len->setName(paramName + ".len");
+            if (!param.structName.empty() && StructTypes.at(param.structName).soa) {
+                cap = &*argIter++;
+                cap->setName(paramName + ".cap");
+            }
+
+            llvm::StructType* headerTy = getDynArrayType(data->getType()->getPointerElementType());
+            llvm::Value* header = llvm::UndefValue::get(headerTy);
+            header = builder.CreateInsertValue(header, data, 0);
+            header = builder.CreateInsertValue(header, len, 1);
+            header = builder.CreateInsertValue(header, cap, 2);
+            llvm::AllocaInst* alloc = createEntryBlockAlloca(function, paramName, headerTy);
+            builder.CreateStore(header, alloc);
+
+            VarInfo varInfo = { alloc, param.dataType, true, 0, true };
+            varInfo.isDynamic = true;
+            varInfo.isBorrowed = true;
+            varInfo.structTypeName = param.structName;
+            VariablesStack.back()[paramName] = varInfo;
+            continue;
         }
 
-        
-        const std::string& paramName = varDecl->name;
-        argIter->setName(paramName);
+        llvm::Argument* arg = &*argIter++;
+        arg->setName(paramName);
+
+        // struct: salinan milik function, by value (register) atau disalin dari pointer pemanggil
+        if (!param.structName.empty()) {
+            llvm::StructType* structTy = StructTypes.at(param.structName).type;
+            llvm::AllocaInst* alloc = createEntryBlockAlloca(function, paramName, structTy);
+            builder.CreateStore(arg->getType()->isPointerTy() ? builder.CreateLoad(structTy, arg) : static_cast<llvm::Value*>(arg), alloc);
+            VarInfo varInfo = { alloc, LiteralType::STRUCT, false, 1, true };
+            varInfo.structTypeName = param.structName;
+            VariablesStack.back()[paramName] = varInfo;
+            continue;
+        }
 
-        llvm::AllocaInst* alloc = createEntryBlockAlloca(function, paramName, argTy);
-        builder.CreateStore(argIter, alloc);
+        llvm::AllocaInst* alloc = createEntryBlockAlloca(function, paramName, arg->getType());
+        builder.CreateStore(arg, alloc);
 
-        VariablesStack.back()[paramName] = { alloc, varType, false, 1 };
+        VariablesStack.back()[paramName] = { alloc, param.dataType, false, 1 };
     }
 
+    // arena: kalau data heap function tidak keluar, semua dibuang saat return.
+    // hasil str / array / struct berisi str menunjuk ke data arena, jadi dianggap keluar
+    std::set<std::string> paramNames;
+    for (const ParamInfo& param : params) paramNames.insert(param.name);
+    bool allocates = false, escapes = false;
+    scanArenaRegion(funcDecl->body, paramNames, funcDecl->name, allocates, escapes);
+    std::function<bool(llvm::Type*)> hasPointer = [&](llvm::Type* ty){
+        if (ty->isPointerTy()) return true;
+        if (auto st = llvm::dyn_cast<llvm::StructType>(ty))
+            for (llvm::Type* fieldTy : st->elements())
+                if (hasPointer(fieldTy)) return true;
+        return false;
+    };
+    if (sretTy ? hasPointer(sretTy) : info.returnType == LiteralType::STRING) escapes = true;
+    if (!escapes) RegionSafeFunctions.insert(funcDecl->name);
+    else RegionSafeFunctions.erase(funcDecl->name);
 
-    // inferred return type
-    // llvm::Type* inferredRetType = builder.getInt32Ty(); // default fallback
-    // for (auto& s : funcDecl->body) {
-    //     if (s->type == StmtType::Return) {
-    //         auto retStmt = std::static_pointer_cast<ReturnStmt>(s);
-    //         llvm::Value* retVal = generateExpression(retStmt->value);
-    //         inferredRetType = retVal->getType();
-    //         break; // ambil tipe dari return pertama
-    //     }
-    // }
-
-    // // --- update function type kalau perlu ---
-    // if (retType != builder.getInt32Ty()) {
-    //     llvm::FunctionType* newFuncType = llvm::FunctionType::get(retType, paramTypes, false);
-    //     function->setFunctionType(newFuncType); // LLVM 16 support update? jika tidak, abaikan
-    // }
+    llvm::Value* outerMark = FunctionArenaMark;
+    FunctionArenaMark = (allocates && !escapes) ? beginArenaScope() : nullptr;
 
-    std::cout << "inferred\n";
+    // return f(...) ke diri sendiri: body diberi blok awal sendiri sebagai tujuan loop (lihat emitSelfTailCall)
+    llvm::BasicBlock* outerTailBlock = TailRecurseBlock;
+    std::vector<llvm::Value*> outerTailParams = TailRecurseParams;
+    size_t outerTailDepth = TailRecurseLoopDepth;
+    TailRecurseBlock = nullptr;
+    TailRecurseParams.clear();
+    TailRecurseLoopDepth = BreakTargets.size();
+    bool selfTail = false;
+    std::function<void(const std::shared_ptr<Stmt>&)> findSelfTail = [&](const std::shared_ptr<Stmt>& stmt){
+        if (stmt->type == StmtType::FunctionDecl) return;
+        auto ret = std::dynamic_pointer_cast<ReturnStmt>(stmt);
+        auto call = ret ? std::dynamic_pointer_cast<FunctionCallStmt>(ret->value) : nullptr;
+        if (call && call->name == funcDecl->name) selfTail = true;
+        forEachChild(stmt, findSelfTail);
+    };
+    for (const auto& s : funcDecl->body) findSelfTail(s);
+    if (selfTail) {
+        for (const ParamInfo& param : params) TailRecurseParams.push_back(VariablesStack.back().at(param.name).alloc);
+        TailRecurseBlock = llvm::BasicBlock::Create(context, "tailrecurse", function);
+        builder.CreateBr(TailRecurseBlock);
+        builder.SetInsertPoint(TailRecurseBlock);
+    }
 
     for (auto& s : funcDecl->body) generateStatement(s);
 
-    // kalau gak ada return, tambahin default
-    if (!entry->getTerminator()) builder.CreateRet(llvm::ConstantInt::get(builder.getInt32Ty(), 0));
+    // kalau gak ada return, tambahin default (nilai 0 / buffer sret diisi 0)
+    if (!builder.GetInsertBlock()->getTerminator()) {
+        if (FunctionArenaMark) releaseArenaScope(FunctionArenaMark, true);
+        if (sretTy) builder.CreateStore(llvm::Constant::getNullValue(sretTy), function->getArg(0));
+        if (function->getReturnType()->isVoidTy()) builder.CreateRetVoid();
+        else builder.CreateRet(llvm::Constant::getNullValue(function->getReturnType()));
+    }
+    FunctionArenaMark = outerMark;
+    TailRecurseBlock = outerTailBlock;
+    TailRecurseParams = outerTailParams;
+    TailRecurseLoopDepth = outerTailDepth;
+    inferFunctionAttributes(function);
 
     VariablesStack.pop_back();
-    if (oldBlock) { // balikin insert point ke block sebelumnya (contoh: main)
-        builder.SetInsertPoint(oldBlock);
-    }
-}
\ No newline at end of file
+    return function;
+}
@@ -24,10 +24,17 @@ llvm::Function* CodeGen::getPrintf(llvm::Module *m){
 
 void CodeGen::genPrintString(llvm::Value *strVal, bool enter){
     llvm::Function *printFun = getPrintf(module.get());
-    llvm::Value *fmt;
-    if(enter) fmt = builder.CreateGlobalStringPtr("%s\n");
-    else fmt = builder.CreateGlobalStringPtr("%s");
-    builder.CreateCall(printFun, {fmt, strVal});
+
+    // str aiko bawa panjang sendiri, jadi pakai %.*s (tidak perlu null terminator)
+    if(strVal->getType() == strType){
+        llvm::Value *ptr = builder.CreateExtractValue(strVal, 0, "strptr");
+        llvm::Value *len = builder.CreateTrunc(builder.CreateExtractValue(strVal, 1, "strlen"), builder.getInt32Ty());
+        builder.CreateCall(printFun, {getCString(enter ? "%.*s\n" : "%.*s"), len, ptr});
+        return;
+    }
+
+    // string C biasa (i8*), misal bracket array
+    builder.CreateCall(printFun, {getCString(enter ? "%s\n" : "%s"), strVal});
 }
     
 void CodeGen::genPrintInt(llvm::Value *intVal, bool enter) {
@@ -35,12 +42,24 @@ void CodeGen::genPrintInt(llvm::Value *intVal, bool enter) {
     llvm::Type* valType = intVal->getType();
     llvm::Value *fmt;
 
-    if(valType->isIntegerTy(64)) {
+    bool isUnsigned = isUnsignedValue(intVal);
+
+    // i1 (bool) dan integer kecil dinaikkan ke i32 dulu, varargs printf minimal int
+    // u32 dinaikkan ke i64 supaya nilai di atas 2^31 tidak tercetak negatif
+    if(valType->getIntegerBitWidth() < 32 || (isUnsigned && valType->isIntegerTy(32))) {
+        intVal = castToType(intVal, valType->isIntegerTy(32) ? builder.getInt64Ty() : builder.getInt32Ty());
+        valType = intVal->getType();
+    }
+
+    if(isUnsigned && valType->isIntegerTy(64)) {
+        // u32 / u64 → %lu
+        fmt = getCString(enter ? "%lu\n" : "%lu");
+    } else if(valType->isIntegerTy(64)) {
         // 64-bit integer → %ld
-        fmt = builder.CreateGlobalStringPtr(enter ? "%ld\n" : "%ld");
+        fmt = getCString(enter ? "%ld\n" : "%ld");
     } else {
         // default 32-bit integer → %d
-        fmt = builder.CreateGlobalStringPtr(enter ? "%d\n" : "%d");
+        fmt = getCString(enter ? "%d\n" : "%d");
     }
 
     builder.CreateCall(printFun, {fmt, intVal});
@@ -59,7 +78,7 @@ void CodeGen::genPrintDouble(llvm::Value *doubleVal, bool enter) {
     }
 
     llvm::Value *fmt;
-    if(enter) fmt = builder.CreateGlobalStringPtr("%f\n");
-    else fmt = builder.CreateGlobalStringPtr("%f");
+    if(enter) fmt = getCString("%f\n");
+    else fmt = getCString("%f");
     builder.CreateCall(printFun, {fmt, doubleVal});
 }
\ No newline at end of file
@@ -30,36 +30,9 @@ void CodeGen::handlePrint(const std::shared_ptr<PrintStmt>& printStmtObj, bool e
         std::string name = arrAccess->array_name;
         VarInfo *varInfo = lookupVariable(name);
         if(!varInfo) throw std::runtime_error("Variable not found");
-        
-        llvm::Value *index = generateExpression(arrAccess->index);
-        // if (auto constIntVal = llvm::dyn_cast<llvm::ConstantInt>(index)) {
-        //     int64_t constIndex = constIntVal->getSExtValue();
-        //     if (constIndex >= varInfo->size) {
-        //         throw std::runtime_error("Error: out of the bounds");
-        //     }
-        // }
-        
-        
-        // kalau index adalah pointer ke variabel, load nilainya
-        if (index->getType()->isPointerTy()) {
-            index = builder.CreateLoad(index->getType()->getPointerElementType(), index);
-        }
-        
-        // cast ke i32
-        if (!index->getType()->isIntegerTy(32)) {
-            index = builder.CreateIntCast(index, llvm::Type::getInt32Ty(context), true);
-        }
-        
-        // alamat elemen
-        std::vector<llvm::Value*> indices = {
-            llvm::ConstantInt::get(context, llvm::APInt(32, 0)),
-            index
-        };
 
-        llvm::Value* elementPtr = builder.CreateGEP(varInfo->alloc->getAllocatedType(), varInfo->alloc, indices);
-        
-        // load nilainya
-        val = builder.CreateLoad(elementPtr->getType()->getPointerElementType(), elementPtr);
+        // lewat generateArrayAccess agar ikut bounds check (termasuk array dinamis)
+        val = generateArrayAccess(arrAccess);
         type = varInfo->dataType;
         
     }
@@ -71,9 +44,23 @@ void CodeGen::handlePrint(const std::shared_ptr<PrintStmt>& printStmtObj, bool e
         type = inferLiteralTypeFromLLVM(llvmType);
     }
 
+    // struct (variabel, field struct, elemen array struct, hasil function)
+    std::string structName = structNameOf(val);
+    if (!structName.empty()) {
+        handlePrintStruct(val, structName, enter);
+        return;
+    }
+
     switch (type) {
         case LiteralType::INT_32: genPrintInt(val);    break;
         case LiteralType::INT_64: genPrintInt(val);    break;
+        case LiteralType::INT_8:
+        case LiteralType::INT_16:
+        case LiteralType::UINT_8:
+        case LiteralType::UINT_16:
+        case LiteralType::UINT_32:
+        case LiteralType::UINT_64: genPrintInt(val); break;
+        case LiteralType::FLOAT: genPrintDouble(val); break;
         case LiteralType::DOUBLE: genPrintDouble(val); break;
         case LiteralType::BOOL: genPrintInt(val);    break;
         case LiteralType::STRING: genPrintString(val, enter); break;
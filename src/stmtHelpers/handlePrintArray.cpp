@@ -1,31 +1,104 @@
 #include "../../include/CodeGen.hpp"
 
 void CodeGen::handlePrintArray(const VarInfo* varInfo) {
-    auto arrayTy = llvm::cast<llvm::ArrayType>(varInfo->alloc->getAllocatedType());
-    size_t arraySize = arrayTy->getNumElements();
+    if (varInfo->dataType == LiteralType::STRUCT) throw std::runtime_error("Cannot print an array of structs, print its fields");
+    // multi dimensi: tiap baris diberi kurung sendiri, [[1, 2], [3, 4]]
+    size_t rank = getArrayRank(varInfo);
+    std::string open(rank - 1, '['), close(rank - 1, ']');
+
+    // array dinamis: panjang baru diketahui saat runtime, jadi print pakai loop
+    if (varInfo->isDynamic) {
+        llvm::Function* func = builder.GetInsertBlock()->getParent();
+        llvm::Type* elemTy = getArrayElementType(varInfo);
+        llvm::Value* data = getArrayDataPtr(varInfo);
+        llvm::Value* len = getArrayLength(varInfo);
+
+        // stride tiap dimensi, elemen ke-i membuka baris baru di dimensi d kalau i % stride[d] == 0
+        std::vector<llvm::Value*> strides(rank, builder.getInt64(1));
+        for (size_t d = rank - 1; d > 0; d--)
+            strides[d - 1] = builder.CreateMul(strides[d], getArrayDim(varInfo, d));
+
+        llvm::BasicBlock* preBB = builder.GetInsertBlock();
+        llvm::BasicBlock* condBB = llvm::BasicBlock::Create(context, "print_cond", func);
+        llvm::BasicBlock* bodyBB = llvm::BasicBlock::Create(context, "print_body", func);
+        llvm::BasicBlock* endBB = llvm::BasicBlock::Create(context, "print_end", func);
+
+        genPrintString(getBracketString(true), false);
+        if (rank > 1) genPrintString(getCString(open), false);
+        preBB = builder.GetInsertBlock();
+        builder.CreateBr(condBB);
+
+        builder.SetInsertPoint(condBB);
+        llvm::PHINode* i = builder.CreatePHI(builder.getInt64Ty(), 2, "i");
+        i->addIncoming(builder.getInt64(0), preBB);
+        builder.CreateCondBr(builder.CreateICmpULT(i, len), bodyBB, endBB);
+
+        builder.SetInsertPoint(bodyBB);
+        llvm::BasicBlock* sepBB = llvm::BasicBlock::Create(context, "print_sep", func);
+        llvm::BasicBlock* elemBB = llvm::BasicBlock::Create(context, "print_elem", func);
+        builder.CreateCondBr(builder.CreateICmpEQ(i, builder.getInt64(0)), elemBB, sepBB);
+
+        builder.SetInsertPoint(sepBB);
+        std::vector<llvm::Value*> rowStart;
+        for (size_t d = 0; d + 1 < rank; d++)
+            rowStart.push_back(builder.CreateICmpEQ(builder.CreateURem(i, strides[d]), builder.getInt64(0)));
+        for (llvm::Value* c : rowStart) genPrintString(builder.CreateSelect(c, getCString("]"), getCString("")), false);
+        genPrintString(getCString(", "), false);
+        for (llvm::Value* c : rowStart) genPrintString(builder.CreateSelect(c, getCString("["), getCString("")), false);
+        builder.CreateBr(elemBB);
+
+        builder.SetInsertPoint(elemBB);
+        llvm::Value* el = loadArrayLanes(varInfo, data, i, 1);
+        if (elemTy->isFloatingPointTy())
+            genPrintDouble(el, false);
+        else if (varInfo->dataType == LiteralType::STRING)
+            genPrintString(el, false);
+        else
+            genPrintInt(el, false);
+        llvm::Value* next = builder.CreateAdd(i, builder.getInt64(1), "inext");
+        i->addIncoming(next, builder.GetInsertBlock());
+        builder.CreateBr(condBB);
+
+        builder.SetInsertPoint(endBB);
+        if (rank > 1) genPrintString(getCString(close), false);
+        genPrintString(getBracketString(false), true);
+        return;
+    }
+
+    size_t arraySize = varInfo->size;
+    llvm::Value* data = getArrayDataPtr(varInfo);
+
+    // pemisah antar elemen sudah bisa dihitung saat compile
+    std::vector<size_t> strides(rank, 1);
+    for (size_t d = rank - 1; d > 0; d--) strides[d - 1] = strides[d] * varInfo->shape[d];
+    auto separator = [&](size_t i) {
+        size_t rows = 0;
+        for (size_t d = 0; d + 1 < rank; d++) if (i % strides[d] == 0) rows++;
+        return std::string(rows, ']') + ", " + std::string(rows, '[');
+    };
 
     genPrintString(getBracketString(true), false);
+    if (rank > 1) genPrintString(getCString(open), false);
     for (size_t i = 0; i < arraySize; i++) {
-        llvm::Value* index = llvm::ConstantInt::get(context, llvm::APInt(32, i));
-        std::vector<llvm::Value*> indices = {
-            llvm::ConstantInt::get(context, llvm::APInt(32, 0)),
-            index
-        };
-
-        llvm::Value* elPtr = builder.CreateGEP(varInfo->alloc->getAllocatedType(), varInfo->alloc, indices);
-        llvm::Value* el = builder.CreateLoad(elPtr->getType()->getPointerElementType(), elPtr);
+        // array bool: bit ke-i dari word-nya
+        llvm::Value* el = loadArrayLanes(varInfo, data, builder.getInt64(i), 1);
 
         if (varInfo->dataType == LiteralType::INT_32)
             genPrintInt(el, false);
         else if (varInfo->dataType == LiteralType::INT_64)
             genPrintInt(el, false);
-        // else if (varInfo->dataType == LiteralType::FLOAT)
-        //     genPrintDouble(el, false);
+        else if (varInfo->dataType == LiteralType::FLOAT)
+            genPrintDouble(el, false);
         else if (varInfo->dataType == LiteralType::DOUBLE)
             genPrintDouble(el, false);
+        else if (varInfo->dataType == LiteralType::STRING)
+            genPrintString(el, false);
+        else if (el->getType()->isIntegerTy()) // bool, i8..i64, u8..u64
+            genPrintInt(el, false);
 
         if (i != arraySize - 1)
-        genPrintString(builder.CreateGlobalStringPtr(", "), false);
+        genPrintString(getCString(separator(i + 1)), false);
     }
+    if (rank > 1) genPrintString(getCString(close), false);
     genPrintString(getBracketString(false), true);
 }
\ No newline at end of file
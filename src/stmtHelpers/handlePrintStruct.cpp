@@ -0,0 +1,27 @@
+#include "../../include/CodeGen.hpp"
+
+// print(p) untuk struct: Point{x: 1, y: 2.500000}, field selalu urut sesuai deklarasi
+// (bukan urutan di memori, struct @reorder bisa menyusun ulang field-nya)
+void CodeGen::handlePrintStruct(llvm::Value* ptr, const std::string& structName, bool enter){
+    StructInfo& info = StructTypes.at(structName);
+    genPrintString(getCString(structName + "{"), false);
+
+    for(size_t i = 0; i < info.fieldOrder.size(); i++){
+        const std::string& fieldName = info.fieldOrder[i];
+        unsigned index = info.fieldIndices.at(fieldName);
+        genPrintString(getCString((i ? ", " : "") + fieldName + ": "), false);
+
+        llvm::Value* fieldPtr = builder.CreateStructGEP(info.type, ptr, index, fieldName + "_ptr");
+        auto nested = info.fieldStructs.find(fieldName);
+        if(nested != info.fieldStructs.end()){
+            handlePrintStruct(fieldPtr, nested->second, false);
+            continue;
+        }
+        llvm::Type* fieldTy = info.type->getElementType(index);
+        llvm::Value* val = markUnsigned(builder.CreateLoad(fieldTy, fieldPtr, fieldName), isUnsignedType(info.fieldTypes.at(fieldName)));
+        if(fieldTy->isFloatingPointTy()) genPrintDouble(val, false);
+        else if(fieldTy->isIntegerTy()) genPrintInt(val, false);
+        else genPrintString(val, false);
+    }
+    genPrintString(getCString("}"), enter);
+}
@@ -1,17 +1,145 @@
 #include "../../include/CodeGen.hpp"
 
 void CodeGen::handleReturn(const std::shared_ptr<ReturnStmt>& ret){
+    auto* func = builder.GetInsertBlock()->getParent();
+    const FunctionInfo* info = nullptr;
+    auto found = Functions.find(func->getName().str());
+    if(found != Functions.end()) info = &found->second;
+
     if (ret->value) {
+        // return array: header { data, len, cap } ditulis ke buffer pemanggil
+        auto id = std::dynamic_pointer_cast<IdentifierStmt>(ret->value);
+        VarInfo* arrVar = id ? lookupVariable(id->name) : nullptr;
+        if(arrVar && arrVar->isArray){
+            if(arrVar->dataType == LiteralType::STRUCT)
+                throw std::runtime_error(func->getName().str() + ": arrays of structs cannot be returned, pass the array as a parameter");
+            if(InferringReturn){
+                if(InferringReturn->returnType != LiteralType::UNKNOWN &&
+                   (!InferringReturn->returnsArray || InferringReturn->returnType != arrVar->dataType))
+                    throw std::runtime_error(func->getName().str() + ": all return values must have the same type");
+                InferringReturn->returnType = arrVar->dataType;
+                InferringReturn->returnsArray = true;
+                builder.CreateUnreachable();
+                return;
+            }
+            if(!info || !info->returnsArray || info->returnType != arrVar->dataType)
+                throw std::runtime_error(func->getName().str() + ": returned array does not match the return type");
+            storeReturnedArray(arrVar, func->getArg(0));
+            if(FunctionArenaMark) releaseArenaScope(FunctionArenaMark, true);
+            builder.CreateRetVoid();
+            return;
+        }
+
+        // return f(...) ke diri sendiri jadi loop (tidak saat generate percobaan, hasil call-nya dibutuhkan)
+        auto call = std::dynamic_pointer_cast<FunctionCallStmt>(ret->value);
+        if(call && !InferringReturn && emitSelfTailCall(call, func)) return;
+
         llvm::Value* retVal = generateExpression(ret->value);
+        std::string structName = structNameOf(retVal);
+
+        // generate percobaan: cukup catat tipe nilai, tipe yang berbeda digabung seperti operasi biner
+        if(InferringReturn){
+            FunctionInfo& seen = *InferringReturn;
+            bool first = seen.returnType == LiteralType::UNKNOWN;
+            if(!structName.empty()){
+                if(!first && seen.returnStruct != structName)
+                    throw std::runtime_error(func->getName().str() + ": all return values must have the same type");
+                seen.returnType = LiteralType::STRUCT;
+                seen.returnStruct = structName;
+            } else {
+                LiteralType valType = valueLiteralType(retVal);
+                if(valType == LiteralType::UNKNOWN)
+                    throw std::runtime_error(func->getName().str() + ": cannot return this value");
+                if(first) seen.returnType = valType;
+                else if(seen.returnType != valType){
+                    llvm::Type* seenTy = seen.returnsAggregate() ? nullptr : literalTypeToLLVM(seen.returnType);
+                    bool numeric = seenTy && (seenTy->isIntegerTy() || seenTy->isFloatingPointTy()) &&
+                                   (retVal->getType()->isIntegerTy() || retVal->getType()->isFloatingPointTy());
+                    if(!numeric) throw std::runtime_error(func->getName().str() + ": all return values must have the same type");
+                    llvm::Type* merged = promoteBinaryType(seenTy, retVal->getType());
+                    seen.returnType = inferLiteralTypeFromLLVM(merged, isUnsignedType(seen.returnType) && isUnsignedType(valType));
+                }
+            }
+            builder.CreateUnreachable();
+            return;
+        }
+
+        // struct: kecil dikembalikan by value (register), besar disalin ke buffer sret
+        if(info && !info->returnStruct.empty()){
+            if(structName != info->returnStruct)
+                throw std::runtime_error(func->getName().str() + " must return a " + info->returnStruct);
+            llvm::StructType* structTy = StructTypes.at(structName).type;
+            llvm::Value* value = builder.CreateLoad(structTy, retVal);
+            if(FunctionArenaMark) releaseArenaScope(FunctionArenaMark, true);
+            if(info->sret){
+                builder.CreateStore(value, func->getArg(0));
+                builder.CreateRetVoid();
+            } else {
+                builder.CreateRet(value);
+            }
+            return;
+        }
+
+        llvm::Type* retTy = func->getReturnType();
+        if (retTy->isVoidTy() || (info && info->returnsAggregate()))
+            throw std::runtime_error(func->getName().str() + ": return value does not match the return type");
+        if (retVal->getType() != retTy){
+            bool numeric = (retVal->getType()->isIntegerTy() || retVal->getType()->isFloatingPointTy()) &&
+                           (retTy->isIntegerTy() || retTy->isFloatingPointTy());
+            if(!numeric) throw std::runtime_error(func->getName().str() + ": return value does not match the return type");
+            retVal = castToType(retVal, retTy, info && isUnsignedType(info->returnType));
+        }
+        markTailCall(retVal, func);
+        if(FunctionArenaMark) releaseArenaScope(FunctionArenaMark, true);
         builder.CreateRet(retVal);
     } else {
-        // kalau function bukan void → paksa return 0
-        auto* func = builder.GetInsertBlock()->getParent();
-        if (func->getReturnType()->isVoidTy()) {
+        // return tanpa nilai di function yang punya tipe return → nilai 0
+        if(InferringReturn){
+            builder.CreateUnreachable();
+            return;
+        }
+        if(FunctionArenaMark) releaseArenaScope(FunctionArenaMark, true);
+        if (info && info->sret) {
+            llvm::Type* bufTy = func->getArg(0)->getType()->getPointerElementType();
+            builder.CreateStore(llvm::Constant::getNullValue(bufTy), func->getArg(0));
+            builder.CreateRetVoid();
+        } else if (func->getReturnType()->isVoidTy()) {
             builder.CreateRetVoid();
         } else {
-            builder.CreateRet(llvm::ConstantInt::get(builder.getInt32Ty(), 0));
+            builder.CreateRet(llvm::Constant::getNullValue(func->getReturnType()));
         }
     }
     return;
-}
\ No newline at end of file
+}
+
+
+// array lokal dinamis cukup dipindah headernya (datanya di arena, function tidak me-release arena
+// kalau hasilnya array). array statis / parameter disalin ke data arena baru supaya hasilnya
+// tidak menunjuk ke stack function atau ke array milik pemanggil
+void CodeGen::storeReturnedArray(VarInfo* var, llvm::Value* dest){
+    if(getArrayRank(var) != 1) throw std::runtime_error("Only one-dimensional arrays can be returned");
+    llvm::Type* headerTy = dest->getType()->getPointerElementType();
+
+    if(var->isDynamic && !var->isBorrowed){
+        builder.CreateStore(builder.CreateLoad(headerTy, var->alloc), dest);
+        return;
+    }
+
+    bool isBits = isBitArray(var);
+    llvm::Type* storageTy = isBits ? builder.getInt64Ty() : getArrayElementType(var);
+    llvm::Value* len = getArrayLength(var);
+    llvm::Value* count = isBits ? bitWordCount(len) : len;
+    llvm::Value* bytes = builder.CreateMul(count, llvm::ConstantExpr::getSizeOf(storageTy));
+
+    llvm::FunctionCallee allocFunc = module->getOrInsertFunction("aiko_arena_alloc",
+        llvm::FunctionType::get(builder.getInt8PtrTy(), {builder.getInt64Ty()}, false));
+    llvm::Value* raw = builder.CreateCall(allocFunc, {bytes});
+    builder.CreateMemCpy(raw, llvm::MaybeAlign(), builder.CreateBitCast(getArrayDataPtr(var), builder.getInt8PtrTy()),
+                         llvm::MaybeAlign(), bytes);
+
+    llvm::Value* header = llvm::UndefValue::get(headerTy);
+    header = builder.CreateInsertValue(header, builder.CreateBitCast(raw, storageTy->getPointerTo()), 0);
+    header = builder.CreateInsertValue(header, len, 1);
+    header = builder.CreateInsertValue(header, isBits ? builder.CreateShl(count, 6) : len, 2);
+    builder.CreateStore(header, dest);
+}
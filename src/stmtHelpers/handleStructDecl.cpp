@@ -7,12 +7,51 @@ void CodeGen::handleStructDecl(const std::shared_ptr<StructStmt>& structStmt){
         throw std::runtime_error("Struct already defined: " + structStmt->name);
     }
 
+    bool soa = false, reorder = false;
+    for(const auto& annotation : structStmt->annotations){
+        if(annotation == "soa") soa = true;
+        else if(annotation == "reorder") reorder = true;
+        else throw std::runtime_error("Unknown struct annotation: @" + annotation);
+    }
+
+    std::vector<llvm::Type*> sourceTypes;
+    std::vector<std::string> fieldOrder;
+    std::unordered_map<std::string, LiteralType> fieldLiteralTypes;
+    std::unordered_map<std::string, std::string> fieldStructs;
+
+    for(const auto& field : structStmt->fields){
+        if(fieldLiteralTypes.count(field->name))
+            throw std::runtime_error("Duplicate field " + field->name + " in struct " + structStmt->name);
+        if(field->type == LiteralType::STRUCT){
+            // struct di dalam struct disimpan langsung (bukan pointer), harus sudah dideklarasikan
+            auto inner = StructTypes.find(field->structName);
+            if(inner == StructTypes.end())
+                throw std::runtime_error("Unknown struct type: " + field->structName);
+            sourceTypes.push_back(inner->second.type);
+            fieldStructs[field->name] = field->structName;
+        } else {
+            sourceTypes.push_back(literalTypeToLLVM(field->type));
+        }
+        fieldOrder.push_back(field->name);
+        fieldLiteralTypes[field->name] = field->type;
+    }
+
+    // @reorder: field disusun dari align terbesar ke terkecil supaya padding minimal
+    // (bool, i64, bool = 24 byte jadi i64, bool, bool = 16 byte). urutan sama tetap urutan source
+    std::vector<size_t> layout(sourceTypes.size());
+    for(size_t i = 0; i < layout.size(); i++) layout[i] = i;
+    if(reorder){
+        const llvm::DataLayout& dataLayout = module->getDataLayout();
+        std::stable_sort(layout.begin(), layout.end(), [&](size_t a, size_t b){
+            return dataLayout.getABITypeAlign(sourceTypes[a]).value() > dataLayout.getABITypeAlign(sourceTypes[b]).value();
+        });
+    }
+
     std::vector<llvm::Type*> fieldTypes;
     std::unordered_map<std::string, unsigned> fieldIndices;
-
-    for(size_t i = 0; i < structStmt->fields.size(); ++i){
-        fieldTypes.push_back(literalTypeToLLVM(structStmt->fields[i]->type));
-        fieldIndices[structStmt->fields[i]->name] = i;
+    for(size_t i = 0; i < layout.size(); i++){
+        fieldTypes.push_back(sourceTypes[layout[i]]);
+        fieldIndices[fieldOrder[layout[i]]] = i;
     }
 
     llvm::StructType* structType = llvm::StructType::create(context, fieldTypes, structStmt->name);
@@ -20,6 +59,10 @@ void CodeGen::handleStructDecl(const std::shared_ptr<StructStmt>& structStmt){
     StructInfo info;
     info.type = structType;
     info.fieldIndices = std::move(fieldIndices);
+    info.fieldTypes = std::move(fieldLiteralTypes);
+    info.fieldStructs = std::move(fieldStructs);
+    info.fieldOrder = std::move(fieldOrder);
+    info.soa = soa;
 
     StructTypes[structStmt->name] = std::move(info);
 }
\ No newline at end of file
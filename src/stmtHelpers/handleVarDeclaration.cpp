@@ -1,120 +1,162 @@
 #include "../../include/CodeGen.hpp"
 
 void CodeGen::handleVarDeclaration(const std::shared_ptr<VarDeclStmt>& varDeclStmt){
-    llvm::AllocaInst* allocVar = nullptr;
+    llvm::Value* allocVar = nullptr;
     LiteralType varType = varDeclStmt->varType;
     bool isArray = false;
     size_t size = 1;
 
-    llvm::Function *currentFunc = builder.GetInsertBlock()->getParent();
-
     bool isStaticType = varDeclStmt->hasExplicit;
 
    // Kalau deklarasi tanpa inisialisasi
+   // var p: Point; -> semua field 0
+   if (!varDeclStmt->initializer && !varDeclStmt->structName.empty()) {
+        auto it = StructTypes.find(varDeclStmt->structName);
+        if(it == StructTypes.end()) throw std::runtime_error("Unknown struct type: " + varDeclStmt->structName);
+        allocVar = createVariableStorage(varDeclStmt->name, it->second.type);
+        storeInitialValue(allocVar, llvm::Constant::getNullValue(it->second.type));
+        VarInfo info = { allocVar, LiteralType::STRUCT, false, 1, true };
+        info.structTypeName = varDeclStmt->structName;
+        VariablesStack.back()[varDeclStmt->name] = info;
+        return;
+   }
    if (!varDeclStmt->initializer) {
         if (!isStaticType) {
             varType = LiteralType::INT_32; // default
         }
         llvm::Type* llvmTy = literalTypeToLLVM(varType);
-        allocVar = createEntryBlockAlloca(currentFunc, varDeclStmt->name, llvmTy);
+        allocVar = createVariableStorage(varDeclStmt->name, llvmTy);
 
         // nilai default (misalnya 0)
-        builder.CreateStore(defaultValueForType(varType), allocVar);
+        storeInitialValue(allocVar, defaultValueForType(varType));
         VariablesStack.back()[varDeclStmt->name] = { allocVar, varType, isArray, size, isStaticType };
         return;
     }
 
 
-    llvm::Value* initVal = generateExpression(varDeclStmt->initializer);
+    // var c = a * b + d / var c = and(a, b): array baru hasil operasi elementwise
+    auto initType = varDeclStmt->initializer->type;
+    if((initType == StmtType::BinaryOp || initType == StmtType::UnaryOp || initType == StmtType::FunctionCall) &&
+       isElementwiseExpr(varDeclStmt->initializer)){
+        generateElementwise(varDeclStmt->name, varDeclStmt->initializer, true);
+        return;
+    }
+
+    // tipe eksplisit skalar (var x: f32 = 1.5): nilai awal dikonversi ke tipe itu
+    bool explicitScalar = isStaticType && varType != LiteralType::UNKNOWN && varType != LiteralType::STRUCT;
+    llvm::Value* initVal = nullptr;
+    LiteralType literalElemType = LiteralType::UNKNOWN;
+    if(initType == StmtType::ArrayLiteral)
+        initVal = generateArrayLiteral(std::static_pointer_cast<ArrayLiteralStmt>(varDeclStmt->initializer),
+                                       explicitScalar ? varType : LiteralType::UNKNOWN, &literalElemType);
+    else
+        initVal = generateExpression(varDeclStmt->initializer);
     if(!initVal) { 
         std::runtime_error("Error generating initializer\n"); 
         return; 
     }
+    if(explicitScalar && initType != StmtType::ArrayLiteral && initType != StmtType::DynArrayNew && initType != StmtType::StructInit)
+        initVal = castToType(initVal, literalTypeToLLVM(varType), isUnsignedType(varType));
 
     // alokasi memori
     // Pilih tipe Alloca sesuai ekspresi
-    if(varDeclStmt->initializer->type == StmtType::StructInit){
-        auto structInitStmt = std::static_pointer_cast<StructExpr>(varDeclStmt->initializer);
-    
-        // Ambil LLVM StructType dari StructTypes
-        auto it = StructTypes.find(structInitStmt->name);
-        if(it == StructTypes.end())
-            throw std::runtime_error("Unknown struct type: " + structInitStmt->name);
-    
-        llvm::StructType* structType = it->second.type;
-    
-        // alokasi AllocaInst untuk struct
-        allocVar = createEntryBlockAlloca(currentFunc, varDeclStmt->name, structType, 1);
-    
-        // isi field jika ada nilai awal
-        for(size_t i=0; i<structInitStmt->fieldsValue.size(); ++i){
-            auto& field = structInitStmt->fieldsValue[i];
-            unsigned fieldIndex = it->second.fieldIndices[field.first];
-            llvm::Value* fieldPtr = builder.CreateStructGEP(structType, allocVar, fieldIndex, field.first + "_ptr");
-            llvm::Value* value = generateExpression(field.second);
-            builder.CreateStore(value, fieldPtr);
+    // struct: literal / hasil function sudah berada di alloca baru, langsung dipakai sebagai variabel.
+    // struct dari variabel lain atau field (q = p, q = line.start) disalin dengan satu load + store
+    std::string structName = initType == StmtType::ArrayLiteral ? "" : structNameOf(initVal);
+    if(!structName.empty()){
+        if(!varDeclStmt->structName.empty() && varDeclStmt->structName != structName)
+            throw std::runtime_error("Error: " + varDeclStmt->name + " is declared as " + varDeclStmt->structName + " but initialized with " + structName);
+        // di top-level hasil literal / call sudah berupa global baru (lihat createVariableStorage)
+        bool fresh = llvm::isa<llvm::AllocaInst>(initVal) || llvm::isa<llvm::GlobalVariable>(initVal);
+        bool owned = fresh && (initType == StmtType::StructInit || initType == StmtType::FunctionCall);
+        if(owned){
+            allocVar = initVal;
+            allocVar->setName(varDeclStmt->name);
+        } else {
+            llvm::StructType* structType = StructTypes.at(structName).type;
+            allocVar = createVariableStorage(varDeclStmt->name, structType);
+            builder.CreateStore(builder.CreateLoad(structType, initVal), allocVar);
         }
-    
-        // simpan ke stack dengan pointer yang benar
-        VariablesStack.back()[varDeclStmt->name] = {
-            allocVar,       // penting! harus pointer AllocaInst struct
-            LiteralType::STRUCT,
-            false,          // isArray
-            1,              // size
-            isStaticType,
-            structInitStmt->name // nama tipe struct
-        };
+
+        VarInfo info = { allocVar, LiteralType::STRUCT, false, 1, isStaticType };
+        info.structTypeName = structName;
+        VariablesStack.back()[varDeclStmt->name] = info;
         return;
-    }    
-    else if(varDeclStmt->initializer->type == StmtType::ArrayLiteral){
+    }
+    if(varDeclStmt->initializer->type == StmtType::ArrayLiteral){
         // std::cout << "skrg variabel sudah menunjuk alamat pertama\n";
         auto arrStmt = std::static_pointer_cast<ArrayLiteralStmt>(varDeclStmt->initializer);
 
-        llvm::Value *firstVal = generateExpression(arrStmt->elements[0]);
-        varType = inferLiteralTypeFromLLVM(firstVal->getType());
-        allocVar = static_cast<llvm::AllocaInst*>(initVal);
+        allocVar = initVal;
+        allocVar->setName(varDeclStmt->name);
+        varType = literalElemType;
 
-        isArray = true;
-        size = sizeofArray(arrStmt);
+        // literal bersarang: data tetap rata, shape disimpan untuk hitung index
+        std::vector<size_t> shape = arrayLiteralShape(arrStmt);
+        size = 1;
+        for(size_t dim : shape) size *= dim;
+        VarInfo info = { allocVar, varType, true, size, isStaticType };
+        info.shape = shape;
+        VariablesStack.back()[varDeclStmt->name] = info;
+        return;
+    }
+    else if(varDeclStmt->initializer->type == StmtType::DynArrayNew){
+        // initVal = header { data, len, cap }, disimpan di alloca milik variabel
+        auto dynStmt = std::static_pointer_cast<DynArrayExpr>(varDeclStmt->initializer);
+        allocVar = createVariableStorage(varDeclStmt->name, initVal->getType());
+        storeInitialValue(allocVar, initVal);
+
+        VarInfo info = { allocVar, dynStmt->elemType, true, 0, isStaticType };
+        info.isDynamic = true;
+        info.structTypeName = dynStmt->structName;
+        VariablesStack.back()[varDeclStmt->name] = info;
+        return;
     }
     else if(varDeclStmt->initializer->type == StmtType::Literal) {
-        auto literalStmt = std::static_pointer_cast<LiteralStmt>(varDeclStmt->initializer);
-        llvm::Type *llvmTy = literalTypeToLLVM(literalStmt->dataType);
+        llvm::Type *llvmTy = initVal->getType();
 
-        varType = literalStmt->dataType;
-        allocVar = createEntryBlockAlloca(currentFunc, varDeclStmt->name, llvmTy);
+        varType = valueLiteralType(initVal);
+        allocVar = createVariableStorage(varDeclStmt->name, llvmTy);
     }
     else if(varDeclStmt->initializer->type == StmtType::FunctionCall){ // menyimpan nilai return dari expression function
-        auto callExpr = std::static_pointer_cast<FunctionCallStmt>(varDeclStmt->initializer);
-        llvm::Value* callVal = generateExpression(callExpr);
-        if (!callVal) throw std::runtime_error("Error generating function call initializer for variable " + varDeclStmt->name);
-    
-        llvm::Type* allocType = callVal->getType();
-        allocVar = createEntryBlockAlloca(mainFun, varDeclStmt->name, allocType);
-    
-        builder.CreateStore(callVal, allocVar);
-        varType = inferLiteralTypeFromLLVM(allocType);
-        VariablesStack.back()[varDeclStmt->name] = { allocVar, varType, false, 1, isStaticType };
+        auto call = std::static_pointer_cast<FunctionCallStmt>(varDeclStmt->initializer);
+        if(initVal->getType()->isVoidTy())
+            throw std::runtime_error(call->name + " does not return a value");
+
+        // hasil array sudah ada di buffer sret milik pemanggil, buffer itu langsung jadi variabel
+        auto result = CallResults.find(initVal);
+        if(result != CallResults.end() && Functions.at(result->second).returnsArray){
+            initVal->setName(varDeclStmt->name);
+            VarInfo info = { initVal, Functions.at(result->second).returnType, true, 0, isStaticType };
+            info.isDynamic = true;
+            VariablesStack.back()[varDeclStmt->name] = info;
+            return;
+        }
+
+        // initVal sudah hasil call, jangan di-generate ulang (function bisa punya efek samping)
+        llvm::Type* allocType = initVal->getType();
+        allocVar = createVariableStorage(varDeclStmt->name, allocType);
+        varType = valueLiteralType(initVal);
     }
     else if(varDeclStmt->initializer->type == StmtType::Input){
         // ambil tipe LLVM dari value yang sudah dikonversi
         llvm::Type* llvmType = initVal->getType();
 
         // alokasi variabel sesuai tipe target
-        allocVar = createEntryBlockAlloca(currentFunc, varDeclStmt->name, llvmType);
+        allocVar = createVariableStorage(varDeclStmt->name, llvmType);
 
         // simpan value hasil konversi ke variabel
         builder.CreateStore(initVal, allocVar);
 
         // set varType sesuai literal type
-        varType = inferLiteralTypeFromLLVM(llvmType);
+        varType = valueLiteralType(initVal);
     }    
     else { 
         // asumsi binary op → INT (bisa dikembangkan sesuai tipe ekspresi)
         llvm::Type *allocType = initVal->getType();
-        allocVar = createEntryBlockAlloca(currentFunc, varDeclStmt->name, allocType);
-        // infer tipe literal dari LLVM Type
-        varType = inferLiteralTypeFromLLVM(allocType);
+        allocVar = createVariableStorage(varDeclStmt->name, allocType);
+        // infer tipe literal dari LLVM Type (signed / unsigned dari nilainya)
+        varType = valueLiteralType(initVal);
     }
 
     // masukkan nilai ke alamat
@@ -124,8 +166,34 @@ void CodeGen::handleVarDeclaration(const std::shared_ptr<VarDeclStmt>& varDeclSt
     }    
     else if (varDeclStmt->initializer->type != StmtType::ArrayLiteral) {
         // Kalau array, gak perlu store, karena sudah pointer
-        builder.CreateStore(initVal, allocVar);
+        storeInitialValue(allocVar, initVal);
     }
+    if(explicitScalar) varType = varDeclStmt->varType;
     VariablesStack.back()[varDeclStmt->name] = { allocVar, varType, isArray, size, isStaticType };
     // std::cout << "Variabel yang di masukkan array ?: " << VariablesStack.back()[varDeclStmt->name].isArray << '\n';
+}
+
+
+// global top-level yang isinya tidak pernah diubah (nilai awal konstan, tidak ada store / call yang menulis)
+// ditandai constant, llvm bisa membaca isinya saat compile dan datanya masuk .rodata
+void CodeGen::markReadOnlyGlobal(const std::shared_ptr<VarDeclStmt>& varDeclStmt){
+    VarInfo* var = lookupVariable(varDeclStmt->name);
+    auto* global = var ? llvm::dyn_cast<llvm::GlobalVariable>(var->alloc) : nullptr;
+    if(!global || var->isDynamic || WrittenNames.count(varDeclStmt->name)) return;
+
+    auto initType = varDeclStmt->initializer ? varDeclStmt->initializer->type : StmtType::Literal;
+    if(initType != StmtType::Literal && initType != StmtType::ArrayLiteral && initType != StmtType::StructInit) return;
+
+    // nilai awal yang tidak konstan ditulis dengan store (lewat GEP untuk elemen array)
+    std::function<bool(llvm::Value*)> stored = [&](llvm::Value* ptr){
+        for(llvm::User* user : ptr->users()){
+            if(auto* store = llvm::dyn_cast<llvm::StoreInst>(user)){
+                if(store->getPointerOperand() == ptr) return true;
+            } else if(llvm::isa<llvm::GEPOperator>(user) || llvm::isa<llvm::BitCastOperator>(user)){
+                if(stored(user)) return true;
+            } else if(!llvm::isa<llvm::LoadInst>(user)) return true;
+        }
+        return false;
+    };
+    if(!stored(global)) global->setConstant(true);
 }
\ No newline at end of file
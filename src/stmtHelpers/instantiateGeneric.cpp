@@ -0,0 +1,55 @@
+#include "../../include/CodeGen.hpp"
+
+// nama tipe untuk nama instance: add.i32.f64, sum.arr_f32, len2.Point
+static std::string mangleType(const ParamInfo& arg){
+    if(!arg.structName.empty()) return arg.structName;
+    switch(arg.dataType){
+        case LiteralType::INT_8: return "i8";
+        case LiteralType::INT_16: return "i16";
+        case LiteralType::INT_32: return "i32";
+        case LiteralType::INT_64: return "i64";
+        case LiteralType::UINT_8: return "u8";
+        case LiteralType::UINT_16: return "u16";
+        case LiteralType::UINT_32: return "u32";
+        case LiteralType::UINT_64: return "u64";
+        case LiteralType::FLOAT: return "f32";
+        case LiteralType::DOUBLE: return "f64";
+        case LiteralType::BOOL: return "bool";
+        case LiteralType::STRING: return "str";
+        default: throw std::runtime_error("Unsupported argument type for generic function");
+    }
+}
+
+// function dengan parameter tanpa tipe dibuat ulang untuk tiap kombinasi tipe argumen,
+// setiap instance bekerja langsung dengan tipe aslinya (tanpa konversi). instance yang sudah ada dipakai lagi
+std::string CodeGen::instantiateGeneric(const std::string& name, const std::vector<ParamInfo>& argTypes){
+    const GenericFunction& generic = GenericFunctions.at(name);
+
+    std::string instanceName = name;
+    for(const ParamInfo& arg : argTypes) instanceName += "." + std::string(arg.isArray ? "arr_" : "") + mangleType(arg);
+    // instance yang dibuat di dalam generate percobaan (cari tipe return) sudah dihapus, jadi cek module juga
+    if(Functions.count(instanceName) && module->getFunction(instanceName)) return instanceName;
+
+    std::vector<std::shared_ptr<Stmt>> params;
+    for(const ParamInfo& arg : argTypes){
+        auto param = std::make_shared<VarDeclStmt>(arg.name, nullptr, arg.dataType, true);
+        param->isArray = arg.isArray;
+        param->structName = arg.structName;
+        params.push_back(param);
+    }
+    auto instance = std::make_shared<FunctionDeclStmt>(instanceName, params, generic.decl->body);
+    instance->hasReturnType = generic.decl->hasReturnType;
+    instance->returnType = generic.decl->returnType;
+    instance->returnStruct = generic.decl->returnStruct;
+    instance->returnsArray = generic.decl->returnsArray;
+    instance->annotations = generic.decl->annotations;
+
+    // body hanya melihat scope yang terlihat saat function dideklarasikan, bukan variabel lokal pemanggil
+    // (stack asli hanya ditukar, VarInfo* yang sedang dipegang pemanggil tetap valid)
+    std::vector<std::map<std::string, VarInfo>> callerScopes;
+    callerScopes.swap(VariablesStack);
+    VariablesStack.assign(callerScopes.begin(), callerScopes.begin() + std::min(generic.scopeDepth, callerScopes.size()));
+    handleFunctionDecl(instance);
+    VariablesStack.swap(callerScopes);
+    return instanceName;
+}
@@ -0,0 +1,59 @@
+#include "../../include/CodeGen.hpp"
+
+// cari parameter array yang isinya ditulis di dalam function: a[i] = x, a = ..., a += ...,
+// load(a, ...), atau dikirim ke function lain yang menulis parameternya.
+// yang tidak pernah ditulis boleh ditandai readonly. ragu = dianggap ditulis.
+void CodeGen::scanParamWrites(const std::shared_ptr<FunctionDeclStmt>& funcDecl, std::vector<ParamInfo>& params){
+    std::map<std::string, size_t> arrayParams;
+    for(size_t i = 0; i < params.size(); i++)
+        if(params[i].isArray) arrayParams[params[i].name] = i;
+    if(arrayParams.empty()) return;
+
+    // index parameter array kalau arg adalah nama parameter itu, -1 kalau bukan
+    auto paramOf = [&](const std::shared_ptr<Stmt>& arg) -> long {
+        auto id = std::dynamic_pointer_cast<IdentifierStmt>(arg);
+        if(!id) return -1;
+        auto it = arrayParams.find(id->name);
+        return it == arrayParams.end() ? -1 : static_cast<long>(it->second);
+    };
+
+    // panggilan rekursif: (parameter yang dikirim, posisi parameter di panggilan), diselesaikan setelah scan
+    std::vector<std::pair<size_t, size_t>> selfArgs;
+
+    std::function<void(const std::shared_ptr<Stmt>&)> scan = [&](const std::shared_ptr<Stmt>& stmt){
+        if(stmt->type == StmtType::Assignment){
+            auto it = arrayParams.find(std::static_pointer_cast<AssignmentStmt>(stmt)->name);
+            if(it != arrayParams.end()) params[it->second].writes = true;
+        }
+        else if(stmt->type == StmtType::FunctionCall){
+            auto call = std::static_pointer_cast<FunctionCallStmt>(stmt);
+            auto callee = Functions.find(call->name);
+            for(size_t k = 0; k < call->args.size(); k++){
+                long p = paramOf(call->args[k]);
+                if(p < 0) continue;
+                if(call->name == funcDecl->name) selfArgs.push_back({static_cast<size_t>(p), k});
+                else if(callee != Functions.end()){
+                    const auto& calleeParams = callee->second.params;
+                    if(k >= calleeParams.size() || !calleeParams[k].isArray || calleeParams[k].writes) params[p].writes = true;
+                }
+                else if(GenericFunctions.count(call->name)) params[p].writes = true; // instance belum tentu ada
+                else if(k == 0 && (call->name == "load" || call->name == "push" || call->name == "pop" || call->name == "reserve"))
+                    params[p].writes = true;
+            }
+        }
+        forEachChild(stmt, scan);
+    };
+    for(const auto& stmt : funcDecl->body) scan(stmt);
+
+    // parameter yang dikirim ke posisi yang ditulis oleh panggilan rekursif ikut ditulis
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(auto [p, k] : selfArgs){
+            if(k < params.size() && params[k].writes && !params[p].writes){
+                params[p].writes = true;
+                changed = true;
+            }
+        }
+    }
+}
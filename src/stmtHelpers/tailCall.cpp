@@ -0,0 +1,84 @@
+#include "../../include/CodeGen.hpp"
+
+// return f(...) di dalam f sendiri: semua argumen dihitung dulu (boleh membaca parameter lama),
+// lalu ditulis ke alloca parameter dan lompat ke awal body. rekursi jadi loop, stack tetap.
+// false = bukan rekursi langsung yang bisa diubah, call dibuat seperti biasa
+bool CodeGen::emitSelfTailCall(const std::shared_ptr<FunctionCallStmt>& call, llvm::Function* func){
+    if(!TailRecurseBlock || call->name != func->getName() || BreakTargets.size() != TailRecurseLoopDepth) return false;
+    const FunctionInfo& info = Functions.at(call->name);
+    if(call->args.size() != info.params.size()) return false; // error dilaporkan generateFunctionCall
+
+    // argumen array harus variabel array yang cocok, dicek sebelum ada kode yang dibuat
+    std::vector<VarInfo*> arrays(call->args.size(), nullptr);
+    for(size_t i = 0; i < call->args.size(); i++){
+        const ParamInfo& param = info.params[i];
+        if(!param.isArray) continue;
+        auto id = std::dynamic_pointer_cast<IdentifierStmt>(call->args[i]);
+        arrays[i] = id ? lookupVariable(id->name) : nullptr;
+        if(!arrays[i] || !arrays[i]->isArray || arrays[i]->dataType != param.dataType ||
+           arrays[i]->structTypeName != param.structName || getArrayRank(arrays[i]) != 1)
+            return false;
+        for(size_t j = 0; j < i; j++){
+            auto other = std::dynamic_pointer_cast<IdentifierStmt>(call->args[j]);
+            if(info.params[j].isArray && other && other->name == id->name && (param.writes || info.params[j].writes))
+                throw std::runtime_error(call->name + ": array " + id->name + " is modified by the function and cannot be passed twice");
+        }
+    }
+
+    std::vector<llvm::Value*> values;
+    for(size_t i = 0; i < call->args.size(); i++){
+        const ParamInfo& param = info.params[i];
+        llvm::Type* slotTy = TailRecurseParams[i]->getType()->getPointerElementType();
+
+        // parameter array: header { data, len, cap } baru dari array argumen (data tidak disalin)
+        if(param.isArray){
+            VarInfo* var = arrays[i];
+            llvm::Value* len = getArrayLength(var);
+            llvm::Value* cap = isSoaArray(var)
+                ? builder.CreateLoad(builder.getInt64Ty(), builder.CreateStructGEP(var->storageType(), var->alloc, 2), "soa_cap")
+                : len;
+            llvm::Value* header = llvm::UndefValue::get(slotTy);
+            header = builder.CreateInsertValue(header, getArrayDataPtr(var), 0);
+            header = builder.CreateInsertValue(header, len, 1);
+            header = builder.CreateInsertValue(header, cap, 2);
+            values.push_back(header);
+            continue;
+        }
+
+        if(!param.structName.empty()){
+            std::string structName;
+            llvm::Value* ptr = structPointer(call->args[i], structName);
+            if(structName != param.structName)
+                throw std::runtime_error(call->name + ": parameter " + param.name + " expects a " + param.structName);
+            values.push_back(builder.CreateLoad(slotTy, ptr));
+            continue;
+        }
+
+        llvm::Value* val = generateExpression(call->args[i]);
+        bool numeric = (val->getType()->isIntegerTy() || val->getType()->isFloatingPointTy()) &&
+                       (slotTy->isIntegerTy() || slotTy->isFloatingPointTy());
+        if(numeric && val->getType() != slotTy) val = castToType(val, slotTy, isUnsignedType(param.dataType));
+        if(val->getType() != slotTy)
+            throw std::runtime_error(call->name + ": parameter " + param.name + " expects a different type");
+        values.push_back(val);
+    }
+
+    for(size_t i = 0; i < values.size(); i++) builder.CreateStore(values[i], TailRecurseParams[i]);
+    builder.CreateBr(TailRecurseBlock);
+    return true;
+}
+
+// return g(...) dengan nilai skalar: call ditandai tail (callee tidak menyentuh alloca pemanggil),
+// musttail kalau signature sama dan tidak ada kode lain antara call dan ret (tanpa release arena)
+void CodeGen::markTailCall(llvm::Value* retVal, llvm::Function* func){
+    auto* call = llvm::dyn_cast<llvm::CallInst>(retVal);
+    llvm::Function* callee = call ? call->getCalledFunction() : nullptr;
+    if(!callee || !Functions.count(callee->getName().str())) return;
+
+    for(llvm::Value* arg : call->args())
+        if(llvm::isa<llvm::AllocaInst>(baseObject(arg))) return; // array / struct lokal dikirim lewat pointer
+
+    bool exact = !FunctionArenaMark && call->getNextNode() == nullptr && call->getParent() == builder.GetInsertBlock() &&
+                 callee->getFunctionType() == func->getFunctionType() && callee->getCallingConv() == func->getCallingConv();
+    call->setTailCallKind(exact ? llvm::CallInst::TCK_MustTail : llvm::CallInst::TCK_Tail);
+}
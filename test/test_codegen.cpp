@@ -29,6 +29,9 @@ int main(int argc, const char* argv[]){
     }
 
     std::string path = argv[1];
+    bool keepUnused = false; // --keep-unused: function / struct / variabel yang tidak dipakai tetap di-generate
+    for(int i = 2; i < argc; i++)
+        if(std::string(argv[i]) == "--keep-unused") keepUnused = true;
     std::string code = readFile(path);
 
     // std::cout << "Isi file:\n" << code << "\n";
@@ -57,7 +60,7 @@ int main(int argc, const char* argv[]){
 
 
     try {
-        CodeGen codegen(ast_tree);
+        CodeGen codegen(ast_tree, keepUnused);
         codegen.run(true);
     }
     catch(const std::exception& e) {